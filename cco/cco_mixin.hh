@@ -27,8 +27,8 @@ namespace parasols
         auto colour_class_order(
                 const SelectColourClassOrderOverload<CCOPermutations::None> &,
                 const FixedBitSet<size_> & p,
-                std::array<VertexType_, size_ * bits_per_word> & p_order,
-                std::array<VertexType_, size_ * bits_per_word> & p_bounds,
+                VertexArray<VertexType_, size_> & p_order,
+                VertexArray<VertexType_, size_> & p_bounds,
                 int = 0) -> void
         {
             FixedBitSet<size_> p_left = p; // not coloured yet
@@ -66,8 +66,8 @@ namespace parasols
         auto colour_class_order(
                 const SelectColourClassOrderOverload<CCOPermutations::Defer1> &,
                 const FixedBitSet<size_> & p,
-                std::array<VertexType_, size_ * bits_per_word> & p_order,
-                std::array<VertexType_, size_ * bits_per_word> & p_bounds,
+                VertexArray<VertexType_, size_> & p_order,
+                VertexArray<VertexType_, size_> & p_bounds,
                 int = 0) -> void
         {
             FixedBitSet<size_> p_left = p; // not coloured yet
@@ -75,7 +75,7 @@ namespace parasols
             VertexType_ i = 0;             // position in p_bounds
 
             VertexType_ d = 0;             // number deferred
-            std::array<VertexType_, size_ * bits_per_word> defer;
+            VertexArray<VertexType_, size_> defer;
 
             // while we've things left to colour
             while (! p_left.empty()) {
@@ -122,8 +122,8 @@ namespace parasols
 
         auto colour_class_order_with_repair(
                 const FixedBitSet<size_> & p,
-                std::array<VertexType_, size_ * bits_per_word> & p_order,
-                std::array<VertexType_, size_ * bits_per_word> & p_bounds,
+                VertexArray<VertexType_, size_> & p_order,
+                VertexArray<VertexType_, size_> & p_bounds,
                 int delta,
                 bool selective,
                 bool do_defer
@@ -131,7 +131,7 @@ namespace parasols
         {
             static_assert(! inverse_, "inverse_ not implemented here");
 
-            static thread_local std::vector<std::pair<int, std::array<VertexType_, size_ * bits_per_word> > > colour_classes;
+            static thread_local std::vector<std::pair<int, VertexArray<VertexType_, size_> > > colour_classes;
 
             FixedBitSet<size_> p_left = p; // not coloured yet
             int colour_classes_end = 0;
@@ -211,7 +211,7 @@ namespace parasols
             VertexType_ colour = 0;        // current colour
             VertexType_ i = 0;             // position in p_bounds
             VertexType_ d = 0;             // number deferred
-            std::array<VertexType_, size_ * bits_per_word> defer;
+            VertexArray<VertexType_, size_> defer;
             for (int colour_class = 0 ; colour_class != colour_classes_end ; ++colour_class) {
                 if (do_defer && 1 == colour_classes[colour_class].first)
                     defer[d++] = colour_classes[colour_class].second[0];
@@ -237,8 +237,8 @@ namespace parasols
         auto colour_class_order(
                 const SelectColourClassOrderOverload<CCOPermutations::RepairAll> &,
                 const FixedBitSet<size_> & p,
-                std::array<VertexType_, size_ * bits_per_word> & p_order,
-                std::array<VertexType_, size_ * bits_per_word> & p_bounds,
+                VertexArray<VertexType_, size_> & p_order,
+                VertexArray<VertexType_, size_> & p_bounds,
                 int delta = 0) -> void
         {
             colour_class_order_with_repair(p, p_order, p_bounds, delta, false, false);
@@ -247,8 +247,8 @@ namespace parasols
         auto colour_class_order(
                 const SelectColourClassOrderOverload<CCOPermutations::RepairAllDefer1> &,
                 const FixedBitSet<size_> & p,
-                std::array<VertexType_, size_ * bits_per_word> & p_order,
-                std::array<VertexType_, size_ * bits_per_word> & p_bounds,
+                VertexArray<VertexType_, size_> & p_order,
+                VertexArray<VertexType_, size_> & p_bounds,
                 int delta = 0) -> void
         {
             colour_class_order_with_repair(p, p_order, p_bounds, delta, false, true);
@@ -257,8 +257,8 @@ namespace parasols
         auto colour_class_order(
                 const SelectColourClassOrderOverload<CCOPermutations::RepairSelected> &,
                 const FixedBitSet<size_> & p,
-                std::array<VertexType_, size_ * bits_per_word> & p_order,
-                std::array<VertexType_, size_ * bits_per_word> & p_bounds,
+                VertexArray<VertexType_, size_> & p_order,
+                VertexArray<VertexType_, size_> & p_bounds,
                 int delta
                 ) -> void
         {
@@ -268,8 +268,8 @@ namespace parasols
         auto colour_class_order(
                 const SelectColourClassOrderOverload<CCOPermutations::RepairSelectedDefer1> &,
                 const FixedBitSet<size_> & p,
-                std::array<VertexType_, size_ * bits_per_word> & p_order,
-                std::array<VertexType_, size_ * bits_per_word> & p_bounds,
+                VertexArray<VertexType_, size_> & p_order,
+                VertexArray<VertexType_, size_> & p_bounds,
                 int delta
                 ) -> void
         {
@@ -278,8 +278,8 @@ namespace parasols
 
         auto colour_class_order_with_repair_fast(
                 const FixedBitSet<size_> & p,
-                std::array<VertexType_, size_ * bits_per_word> & p_order,
-                std::array<VertexType_, size_ * bits_per_word> & p_bounds,
+                VertexArray<VertexType_, size_> & p_order,
+                VertexArray<VertexType_, size_> & p_bounds,
                 int delta,
                 bool selective) -> void
         {
@@ -407,8 +407,8 @@ namespace parasols
         auto colour_class_order(
                 const SelectColourClassOrderOverload<CCOPermutations::RepairSelectedFast> &,
                 const FixedBitSet<size_> & p,
-                std::array<VertexType_, size_ * bits_per_word> & p_order,
-                std::array<VertexType_, size_ * bits_per_word> & p_bounds,
+                VertexArray<VertexType_, size_> & p_order,
+                VertexArray<VertexType_, size_> & p_bounds,
                 int delta = 0) -> void
         {
             colour_class_order_with_repair_fast(p, p_order, p_bounds, delta, true);
@@ -417,8 +417,8 @@ namespace parasols
         auto colour_class_order(
                 const SelectColourClassOrderOverload<CCOPermutations::RepairAllFast> &,
                 const FixedBitSet<size_> & p,
-                std::array<VertexType_, size_ * bits_per_word> & p_order,
-                std::array<VertexType_, size_ * bits_per_word> & p_bounds,
+                VertexArray<VertexType_, size_> & p_order,
+                VertexArray<VertexType_, size_> & p_bounds,
                 int delta = 0) -> void
         {
             colour_class_order_with_repair_fast(p, p_order, p_bounds, delta, false);
@@ -3,29 +3,29 @@
 #include <graph/adj.hh>
 #include <graph/graph.hh>
 #include <graph/graph_file_error.hh>
-#include <boost/regex.hpp>
-#include <fstream>
+#include <graph/input_file.hh>
+#include <graph/tokeniser.hh>
 
 using namespace parasols;
 
-auto parasols::read_adj(const std::string & filename, const GraphOptions & options) -> Graph
+auto parasols::read_adj(InputFile & input, const GraphOptions & options) -> Graph
 {
     Graph result(0, true);
 
-    std::ifstream infile{ filename };
-    if (! infile)
-        throw GraphFileError{ filename, "unable to open file" };
+    const std::string & filename = input.filename();
+    Tokeniser text{ input.begin(), input.end() };
 
-    std::string word;
     int depth = 0;
     std::vector<int> row_values;
     int row = 0;
 
-    while (infile >> word) {
-        if (word == "[") {
+    while (input.skip_whitespace(text)) {
+        auto word = text.read_word();
+
+        if (word.equals("[")) {
             ++depth;
         }
-        else if (word == "]" || word == "],") {
+        else if (word.equals("]") || word.equals("],")) {
             if (--depth < 0)
                 throw GraphFileError{ filename, "too many close brackets" };
 
@@ -47,27 +47,28 @@ auto parasols::read_adj(const std::string & filename, const GraphOptions & optio
                 ++row;
             }
         }
-        else if (! word.empty()) {
-            if (word.at(word.length() - 1) == ',')
-                word.erase(word.length() - 1);
+        else {
+            word.skip_trailing_char(',');
 
-            if (word == "0")
+            if (word.equals("0"))
                 row_values.push_back(0);
-            else if (word == "1")
+            else if (word.equals("1"))
                 row_values.push_back(1);
-            else if (word.empty()) {
+            else if (word.at_end()) {
             }
             else
-                throw GraphFileError{ filename, "unexpected token '" + word + "'" };
+                throw GraphFileError{ filename, "unexpected token '" + word.rest() + "'" };
         }
     }
 
     if (0 != depth || row != result.size() || ! row_values.empty())
         throw GraphFileError{ filename, "couldn't finish reading file" };
 
-    if (! infile.eof())
-        throw GraphFileError{ filename, "error reading file" };
-
     return result;
 }
 
+auto parasols::read_adj(const std::string & filename, const GraphOptions & options) -> Graph
+{
+    InputFile input{ filename };
+    return read_adj(input, options);
+}
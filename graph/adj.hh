@@ -4,6 +4,7 @@
 #define PARASOLS_GUARD_GRAPH_ADJ_HH 1
 
 #include <graph/graph.hh>
+#include <graph/input_file.hh>
 #include <string>
 
 namespace parasols
@@ -14,6 +15,14 @@ namespace parasols
      * \throw GraphFileError
      */
     auto read_adj(const std::string & filename, const GraphOptions &) -> Graph;
+
+    /**
+     * Read a adj format file from an InputFile which has not yet been
+     * used.
+     *
+     * \throw GraphFileError
+     */
+    auto read_adj(InputFile & input, const GraphOptions &) -> Graph;
 }
 
 #endif
@@ -0,0 +1,197 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/binary.hh>
+#include <graph/input_file.hh>
+
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+
+using namespace parasols;
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "binary graph files are little endian");
+
+namespace
+{
+    const char binary_magic[8] = { 'P', 'S', 'L', 'G', 'R', 'A', 'P', 'H' };
+
+    const constexpr std::uint32_t binary_version = 1;
+
+    const constexpr std::uint32_t flag_add_one_for_output = 1;
+    const constexpr std::uint32_t flag_stored_order = 2;
+
+    struct BinaryHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t flags;
+        std::uint64_t size;
+        std::uint64_t words_per_row;
+    };
+
+    static_assert(sizeof(BinaryHeader) == 32, "BinaryHeader should not be padded");
+
+    /* How many words we try to write at once. */
+    const constexpr int block_words = 1 << 17;
+
+    auto order_bytes(std::uint64_t size) -> std::uint64_t
+    {
+        return (size * sizeof(std::int32_t) + 7) / 8 * 8;
+    }
+}
+
+auto parasols::read_binary(InputFile & input, const GraphOptions & options) -> Graph
+{
+    const std::string & filename = input.filename();
+
+    BinaryHeader header;
+    if (sizeof(header) != input.read_bytes(reinterpret_cast<char *>(&header), sizeof(header)))
+        throw GraphFileError{ filename, "file too short to contain a header" };
+
+    if (0 != std::memcmp(header.magic, binary_magic, sizeof(binary_magic)))
+        throw GraphFileError{ filename, "not a binary graph file" };
+    if (binary_version != header.version)
+        throw GraphFileError{ filename, "unsupported version " + std::to_string(header.version) };
+    if (0 != (header.flags & ~(flag_add_one_for_output | flag_stored_order)))
+        throw GraphFileError{ filename, "unsupported flags " + std::to_string(header.flags) };
+    if (header.size > INT_MAX)
+        throw GraphFileError{ filename, "too many vertices" };
+
+    Graph result(0, header.flags & flag_add_one_for_output);
+    result.resize(header.size);
+
+    if (header.words_per_row != std::uint64_t(result.words_per_row()))
+        throw GraphFileError{ filename, "expected " + std::to_string(result.words_per_row()) + " words per row, not "
+                + std::to_string(header.words_per_row) };
+
+    if (header.flags & flag_stored_order) {
+        std::vector<std::int32_t> labels(order_bytes(header.size) / sizeof(std::int32_t));
+        std::size_t label_bytes = labels.size() * sizeof(std::int32_t);
+        if (label_bytes != input.read_bytes(reinterpret_cast<char *>(labels.data()), label_bytes))
+            throw GraphFileError{ filename, "file size does not match header" };
+        labels.resize(header.size);
+
+        std::vector<bool> seen(header.size, false);
+        for (auto & l : labels) {
+            if (l < 0 || unsigned(l) >= header.size || seen[l])
+                throw GraphFileError{ filename, "stored order is not a permutation" };
+            seen[l] = true;
+        }
+
+        result.set_vertex_labels(std::vector<int>(labels.begin(), labels.end()));
+    }
+
+    /* The rows are already in the layout we use, so just copy them in, a
+     * block at a time. We do make sure there's nothing set past the end of
+     * a row. */
+    int last_word = result.words_per_row() - 1;
+    BitWord past_end_mask = (0 == result.size() % bits_per_word) ? 0 : ~BitWord{ 0 } << (result.size() % bits_per_word);
+
+    int rows_per_block = std::max<int>(1, block_words / std::max(1, result.words_per_row()));
+    std::vector<BitWord> block(std::vector<BitWord>::size_type(rows_per_block) * result.words_per_row());
+
+    for (int first = 0 ; first < result.size() ; first += rows_per_block) {
+        int last = std::min(result.size(), first + rows_per_block);
+        std::size_t bytes = std::size_t(last - first) * result.words_per_row() * sizeof(BitWord);
+        if (bytes != input.read_bytes(reinterpret_cast<char *>(block.data()), bytes))
+            throw GraphFileError{ filename, "file size does not match header" };
+
+        for (int v = first ; v < last ; ++v) {
+            auto row = block.data() + std::size_t(v - first) * result.words_per_row();
+            if (row[last_word] & past_end_mask)
+                throw GraphFileError{ filename, "row for vertex " + result.vertex_name(v) + " has bits set past the last vertex" };
+
+            result.set_neighbourhood_words(v, row);
+
+            if (! test(options, GraphOptions::AllowLoops) && result.adjacent(v, v))
+                throw GraphFileError{ filename, "contains a loop on vertex " + result.vertex_name(v) };
+        }
+    }
+
+    char extra;
+    if (0 != input.read_bytes(&extra, 1))
+        throw GraphFileError{ filename, "file size does not match header" };
+
+    return result;
+}
+
+auto parasols::read_binary(const std::string & filename, const GraphOptions & options) -> Graph
+{
+    InputFile input{ filename };
+    return read_binary(input, options);
+}
+
+auto parasols::write_binary(const Graph & graph, const std::vector<int> & order, const std::string & filename) -> void
+{
+    std::ofstream outfile{ filename, std::ios::binary | std::ios::trunc };
+    if (! outfile)
+        throw GraphFileWriteError{ filename, "unable to open file" };
+
+    write_binary(graph, order, outfile);
+
+    if (! outfile)
+        throw GraphFileWriteError{ filename, "error writing file" };
+}
+
+auto parasols::write_binary(const Graph & graph, const std::vector<int> & order, std::ostream & outfile) -> void
+{
+    std::vector<int> inverse(graph.size());
+    bool permuted = false;
+    for (int i = 0 ; i < graph.size() ; ++i) {
+        inverse[order[i]] = i;
+        if (order[i] != i)
+            permuted = true;
+    }
+
+    /* Work out what each row really is, in terms of the original graph. */
+    std::vector<std::int32_t> labels(graph.size());
+    bool identity = true;
+    for (int i = 0 ; i < graph.size() ; ++i) {
+        labels[i] = graph.vertex_labels().empty() ? order[i] : graph.vertex_labels()[order[i]];
+        if (labels[i] != i)
+            identity = false;
+    }
+
+    BinaryHeader header;
+    std::memcpy(header.magic, binary_magic, sizeof(binary_magic));
+    header.version = binary_version;
+    header.flags = (graph.add_one_for_output() ? flag_add_one_for_output : 0) | (identity ? 0 : flag_stored_order);
+    header.size = graph.size();
+    header.words_per_row = graph.words_per_row();
+
+    outfile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    if (! identity) {
+        labels.resize(order_bytes(graph.size()) / sizeof(std::int32_t), 0);
+        outfile.write(reinterpret_cast<const char *>(labels.data()), labels.size() * sizeof(std::int32_t));
+    }
+
+    /* Gather up as many rows as fit in a block, and write them together. */
+    int rows_per_block = std::max<int>(1, block_words / std::max(1, graph.words_per_row()));
+    std::vector<BitWord> block(std::vector<BitWord>::size_type(rows_per_block) * graph.words_per_row());
+
+    for (int first = 0 ; first < graph.size() ; first += rows_per_block) {
+        int last = std::min(graph.size(), first + rows_per_block);
+
+        for (int i = first ; i < last ; ++i) {
+            auto source = graph.neighbourhood_words(order[i]);
+            auto row = block.begin() + std::vector<BitWord>::size_type(i - first) * graph.words_per_row();
+
+            if (! permuted)
+                std::copy(source, source + graph.words_per_row(), row);
+            else {
+                std::fill(row, row + graph.words_per_row(), 0);
+                for (int w = 0 ; w < graph.words_per_row() ; ++w)
+                    for (BitWord bits = source[w] ; bits ; bits &= bits - 1) {
+                        int j = inverse[w * bits_per_word + __builtin_ctzll(bits)];
+                        row[j / bits_per_word] |= (BitWord{ 1 } << (j % bits_per_word));
+                    }
+            }
+        }
+
+        outfile.write(reinterpret_cast<const char *>(block.data()),
+                std::streamsize(last - first) * graph.words_per_row() * sizeof(BitWord));
+    }
+}
@@ -0,0 +1,60 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_BINARY_HH
+#define PARASOLS_GUARD_GRAPH_BINARY_HH 1
+
+#include <graph/graph.hh>
+#include <graph/input_file.hh>
+#include <graph/graph_file_error.hh>
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace parasols
+{
+    /**
+     * Read a binary format file into a Graph.
+     *
+     * The file starts with a 32 byte header: the magic string "PSLGRAPH", a
+     * 32-bit version number, a 32-bit flags word, a 64-bit number of
+     * vertices, and a 64-bit number of words per row. If the stored order
+     * flag is set, this is followed by one 32-bit vertex number for each row,
+     * giving the original vertex it holds, padded to a multiple of eight
+     * bytes. The rest of the file is the adjacency matrix, as rows of 64-bit
+     * words in the same layout Graph uses. Everything is little endian.
+     *
+     * If there is a stored order, the graph we return is the permuted graph,
+     * with vertex labels so that vertices are output using their original
+     * numbers.
+     *
+     * \throw GraphFileError
+     */
+    auto read_binary(const std::string & filename, const GraphOptions & options) -> Graph;
+
+    /**
+     * Read a binary format file from an InputFile which has not yet been
+     * used.
+     *
+     * \throw GraphFileError
+     */
+    auto read_binary(InputFile & input, const GraphOptions &) -> Graph;
+
+    /**
+     * Write a Graph in binary format, with its vertices permuted so that
+     * vertex i in the file is vertex order[i] in the graph. The order is
+     * stored in the file, unless it is the identity.
+     *
+     * \throw GraphFileWriteError
+     */
+    auto write_binary(const Graph & graph, const std::vector<int> & order, const std::string & filename) -> void;
+
+    /**
+     * Write a Graph in binary format to a stream, as above. Rows are
+     * gathered into large blocks before being written. Errors are left on
+     * the stream for the caller to check.
+     */
+    auto write_binary(const Graph & graph, const std::vector<int> & order, std::ostream & stream) -> void;
+}
+
+#endif
@@ -2,7 +2,42 @@
 
 #include <graph/bit_graph.hh>
 
+#include <atomic>
+
 using namespace parasols;
 
+namespace
+{
+    std::atomic<unsigned long long> memory_budget{ 0 };
+}
+
 GraphTooBig::GraphTooBig() throw () = default;
 
+MemoryBudgetExceeded::MemoryBudgetExceeded(unsigned long long needed, unsigned long long budget) :
+    _what("Bit graph needs " + std::to_string(needed / (1024 * 1024)) + "MB, which is over the memory budget of "
+            + std::to_string(budget / (1024 * 1024)) + "MB")
+{
+}
+
+auto MemoryBudgetExceeded::what() const throw () -> const char *
+{
+    return _what.c_str();
+}
+
+auto parasols::set_bit_graph_memory_budget(unsigned long long bytes) -> void
+{
+    memory_budget.store(bytes);
+}
+
+auto parasols::bit_graph_bytes(int size, unsigned words) -> unsigned long long
+{
+    return (unsigned long long)(size) * words * sizeof(BitWord);
+}
+
+auto parasols::check_bit_graph_memory_budget(int size, unsigned words) -> void
+{
+    unsigned long long budget = memory_budget.load();
+    unsigned long long needed = bit_graph_bytes(size, words);
+    if (0 != budget && needed > budget)
+        throw MemoryBudgetExceeded{ needed, budget };
+}
@@ -3,26 +3,40 @@
 #ifndef PARASOLS_GUARD_GRAPH_BIT_GRAPH_HH
 #define PARASOLS_GUARD_GRAPH_BIT_GRAPH_HH 1
 
+#include <graph/bit_kernels.hh>
+
 #include <array>
 #include <vector>
 #include <tuple>
 #include <utility>
 #include <algorithm>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <exception>
+#include <stdexcept>
+
+/**
+ * The largest FixedBitSet size, in words, which the solvers are compiled
+ * for. Each doubling allows twice as many vertices, but adds another
+ * instantiation of every algorithm. Set max_graph_words in main.mk to change
+ * this.
+ */
+#ifndef PARASOLS_MAX_GRAPH_WORDS
+#  define PARASOLS_MAX_GRAPH_WORDS 1024
+#endif
 
 namespace parasols
 {
-    /// We'll use an array of unsigned long longs to represent our bits.
-    using BitWord = unsigned long long;
-
-    /// Number of bits per word.
-    static const constexpr int bits_per_word = sizeof(BitWord) * 8;
-
     /**
      * A bitset with a fixed maximum size. This only provides the operations
      * we actually use in the bitset algorithms: it's more readable this way
      * than doing all the bit voodoo inline.
      *
      * Indices start at 0.
+     *
+     * Big sets do whole-set operations using bit_kernels, which are chosen
+     * at startup according to what the CPU supports.
      */
     template <unsigned words_>
     class FixedBitSet
@@ -53,6 +67,17 @@ namespace parasols
                 __sync_or_and_fetch(&_bits[a / bits_per_word], (BitWord{ 1 } << (a % bits_per_word)));
             }
 
+            /**
+             * Replace our contents with the given words. Any words past
+             * n_words are cleared.
+             */
+            auto set_words(const BitWord * words, int n_words) -> void
+            {
+                n_words = std::min<int>(n_words, words_);
+                std::copy(words, words + n_words, _bits.begin());
+                std::fill(_bits.begin() + n_words, _bits.end(), 0);
+            }
+
             /**
              * Set a given bit 'off'.
              */
@@ -104,6 +129,9 @@ namespace parasols
              */
             auto popcount() const -> unsigned
             {
+                if (words_ >= bit_kernels_min_words)
+                    return bit_kernels.popcount(_bits.data(), words_);
+
                 unsigned result = 0;
                 for (auto & p : _bits)
                     result += __builtin_popcountll(p);
@@ -115,6 +143,9 @@ namespace parasols
              */
             auto empty() const -> bool
             {
+                if (words_ >= bit_kernels_min_words)
+                    return bit_kernels.empty(_bits.data(), words_);
+
                 for (auto & p : _bits)
                     if (0 != p)
                         return false;
@@ -126,6 +157,11 @@ namespace parasols
              */
             auto intersect_with(const FixedBitSet<words_> & other) -> void
             {
+                if (words_ >= bit_kernels_min_words) {
+                    bit_kernels.intersect_with(_bits.data(), other._bits.data(), words_);
+                    return;
+                }
+
                 for (typename Bits::size_type i = 0 ; i < words_ ; ++i)
                     _bits[i] = _bits[i] & other._bits[i];
             }
@@ -144,6 +180,11 @@ namespace parasols
              */
             auto intersect_with_complement(const FixedBitSet<words_> & other) -> void
             {
+                if (words_ >= bit_kernels_min_words) {
+                    bit_kernels.intersect_with_complement(_bits.data(), other._bits.data(), words_);
+                    return;
+                }
+
                 for (typename Bits::size_type i = 0 ; i < words_ ; ++i)
                     _bits[i] = _bits[i] & ~other._bits[i];
             }
@@ -154,6 +195,9 @@ namespace parasols
              */
             auto first_set_bit() const -> int
             {
+                if (words_ >= bit_kernels_min_words)
+                    return bit_kernels.first_set_bit(_bits.data(), words_);
+
                 for (typename Bits::size_type i = 0 ; i < _bits.size() ; ++i) {
                     int b = __builtin_ffsll(_bits[i]);
                     if (0 != b)
@@ -243,6 +287,15 @@ namespace parasols
                 _adjacency[b].set_atomic(a);
             }
 
+            /**
+             * Replace the row for a given vertex with the given words. The
+             * caller must keep the graph symmetric.
+             */
+            auto set_neighbourhood_words(int a, const BitWord * words, int n_words) -> void
+            {
+                _adjacency[a].set_words(words, n_words);
+            }
+
             /**
              * Are vertices a and b adjacent?
              */
@@ -298,7 +351,92 @@ namespace parasols
      * We have to decide at compile time what the largest graph we'll support
      * is.
      */
-    constexpr auto max_graph_words __attribute__((unused)) = 1024;
+    constexpr auto max_graph_words __attribute__((unused)) = PARASOLS_MAX_GRAPH_WORDS;
+
+    static_assert(max_graph_words == 1024 || max_graph_words == 2048 || max_graph_words == 4096,
+            "max_graph_words must be 1024, 2048 or 4096");
+
+    /**
+     * Above this many words, arrays with one entry per vertex are too big to
+     * keep on the stack in every level of a recursive search.
+     */
+    constexpr unsigned max_stack_array_words = 1024;
+
+    /**
+     * A fixed size array which lives on the heap. Used in place of
+     * std::array for per-vertex arrays in very big graphs.
+     */
+    template <typename T_, unsigned n_>
+    class HeapArray
+    {
+        private:
+            std::unique_ptr<T_[]> _data;
+
+        public:
+            HeapArray() :
+                _data(new T_[n_])
+            {
+            }
+
+            HeapArray(const HeapArray & other) :
+                _data(new T_[n_])
+            {
+                std::copy(other._data.get(), other._data.get() + n_, _data.get());
+            }
+
+            HeapArray(HeapArray &&) = default;
+
+            auto operator= (const HeapArray & other) -> HeapArray &
+            {
+                std::copy(other._data.get(), other._data.get() + n_, _data.get());
+                return *this;
+            }
+
+            auto operator= (HeapArray &&) -> HeapArray & = default;
+
+            auto operator[] (std::size_t i) -> T_ &
+            {
+                return _data[i];
+            }
+
+            auto operator[] (std::size_t i) const -> const T_ &
+            {
+                return _data[i];
+            }
+
+            auto at(std::size_t i) -> T_ &
+            {
+                if (i >= n_)
+                    throw std::out_of_range{ "HeapArray::at" };
+                return _data[i];
+            }
+
+            auto at(std::size_t i) const -> const T_ &
+            {
+                if (i >= n_)
+                    throw std::out_of_range{ "HeapArray::at" };
+                return _data[i];
+            }
+
+            auto begin() -> T_ *
+            {
+                return _data.get();
+            }
+
+            auto end() -> T_ *
+            {
+                return _data.get() + n_;
+            }
+    };
+
+    /**
+     * An array with one entry for each vertex of a FixedBitGraph<words_>:
+     * a std::array normally, or a HeapArray for very big graphs.
+     */
+    template <typename T_, unsigned words_>
+    using VertexArray = typename std::conditional<words_ <= max_stack_array_words,
+          std::array<T_, words_ * bits_per_word>,
+          HeapArray<T_, words_ * bits_per_word> >::type;
 
     /**
      * Thrown if we exceed max_graph_words.
@@ -309,6 +447,39 @@ namespace parasols
         public:
             GraphTooBig() throw ();
     };
+
+    /**
+     * Thrown if a bit graph would use more memory than we are allowed.
+     */
+    class MemoryBudgetExceeded :
+        public std::exception
+    {
+        private:
+            std::string _what;
+
+        public:
+            MemoryBudgetExceeded(unsigned long long needed, unsigned long long budget);
+
+            auto what() const throw () -> const char *;
+    };
+
+    /**
+     * Limit how much memory a single bit graph's adjacency rows may use, in
+     * bytes. Zero, the default, means no limit.
+     */
+    auto set_bit_graph_memory_budget(unsigned long long bytes) -> void;
+
+    /**
+     * How many bytes of adjacency rows does a bit graph with this many
+     * vertices and words per row need?
+     */
+    auto bit_graph_bytes(int size, unsigned words) -> unsigned long long;
+
+    /**
+     * Throw MemoryBudgetExceeded if a bit graph with this many vertices and
+     * words per row would go over the budget.
+     */
+    auto check_bit_graph_memory_budget(int size, unsigned words) -> void;
 }
 
 #endif
@@ -0,0 +1,278 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/bit_kernels.hh>
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__)
+#  include <immintrin.h>
+#  define PARASOLS_BIT_KERNELS_X86 1
+#endif
+
+using namespace parasols;
+
+namespace
+{
+    auto scalar_intersect_with(BitWord * bits, const BitWord * other, unsigned n_words) -> void
+    {
+        for (unsigned i = 0 ; i < n_words ; ++i)
+            bits[i] &= other[i];
+    }
+
+    auto scalar_intersect_with_complement(BitWord * bits, const BitWord * other, unsigned n_words) -> void
+    {
+        for (unsigned i = 0 ; i < n_words ; ++i)
+            bits[i] &= ~other[i];
+    }
+
+    auto scalar_popcount(const BitWord * bits, unsigned n_words) -> unsigned
+    {
+        unsigned result = 0;
+        for (unsigned i = 0 ; i < n_words ; ++i)
+            result += __builtin_popcountll(bits[i]);
+        return result;
+    }
+
+    auto scalar_empty(const BitWord * bits, unsigned n_words) -> bool
+    {
+        for (unsigned i = 0 ; i < n_words ; ++i)
+            if (0 != bits[i])
+                return false;
+        return true;
+    }
+
+    auto scalar_first_set_bit(const BitWord * bits, unsigned n_words) -> int
+    {
+        for (unsigned i = 0 ; i < n_words ; ++i)
+            if (0 != bits[i])
+                return i * bits_per_word + __builtin_ctzll(bits[i]);
+        return -1;
+    }
+
+#ifdef PARASOLS_BIT_KERNELS_X86
+    /* Four words at a time, with whatever is left over done a word at a
+     * time. */
+
+    __attribute__((target("avx2")))
+    auto avx2_intersect_with(BitWord * bits, const BitWord * other, unsigned n_words) -> void
+    {
+        unsigned i = 0;
+        for ( ; i + 4 <= n_words ; i += 4) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bits + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(other + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(bits + i), _mm256_and_si256(a, b));
+        }
+
+        for ( ; i < n_words ; ++i)
+            bits[i] &= other[i];
+    }
+
+    __attribute__((target("avx2")))
+    auto avx2_intersect_with_complement(BitWord * bits, const BitWord * other, unsigned n_words) -> void
+    {
+        unsigned i = 0;
+        for ( ; i + 4 <= n_words ; i += 4) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bits + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(other + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(bits + i), _mm256_andnot_si256(b, a));
+        }
+
+        for ( ; i < n_words ; ++i)
+            bits[i] &= ~other[i];
+    }
+
+    /* Mula's method: look up the count for each nibble with a shuffle, and
+     * then sum the bytes of each word. */
+    __attribute__((target("avx2,popcnt")))
+    auto avx2_popcount(const BitWord * bits, unsigned n_words) -> unsigned
+    {
+        const __m256i lookup = _mm256_setr_epi8(
+                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low_mask = _mm256_set1_epi8(0x0f);
+
+        __m256i totals = _mm256_setzero_si256();
+        unsigned i = 0;
+        for ( ; i + 4 <= n_words ; i += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bits + i));
+            __m256i low = _mm256_and_si256(v, low_mask);
+            __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+            __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+            totals = _mm256_add_epi64(totals, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+        }
+
+        unsigned result = _mm256_extract_epi64(totals, 0) + _mm256_extract_epi64(totals, 1) +
+            _mm256_extract_epi64(totals, 2) + _mm256_extract_epi64(totals, 3);
+
+        for ( ; i < n_words ; ++i)
+            result += __builtin_popcountll(bits[i]);
+
+        return result;
+    }
+
+    __attribute__((target("avx2")))
+    auto avx2_empty(const BitWord * bits, unsigned n_words) -> bool
+    {
+        unsigned i = 0;
+        for ( ; i + 4 <= n_words ; i += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bits + i));
+            if (! _mm256_testz_si256(v, v))
+                return false;
+        }
+
+        for ( ; i < n_words ; ++i)
+            if (0 != bits[i])
+                return false;
+
+        return true;
+    }
+
+    __attribute__((target("avx2")))
+    auto avx2_first_set_bit(const BitWord * bits, unsigned n_words) -> int
+    {
+        unsigned i = 0;
+        for ( ; i + 4 <= n_words ; i += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bits + i));
+            if (! _mm256_testz_si256(v, v)) {
+                /* One bit for each word which is zero. */
+                int zeroes = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, _mm256_setzero_si256())));
+                i += __builtin_ctz(~zeroes);
+                return i * bits_per_word + __builtin_ctzll(bits[i]);
+            }
+        }
+
+        for ( ; i < n_words ; ++i)
+            if (0 != bits[i])
+                return i * bits_per_word + __builtin_ctzll(bits[i]);
+
+        return -1;
+    }
+
+    /* Eight words at a time, with a masked load or store for whatever is
+     * left over. */
+
+    auto avx512_tail_mask(unsigned n_left) -> __mmask8
+    {
+        return (1u << n_left) - 1;
+    }
+
+    __attribute__((target("avx512f")))
+    auto avx512_intersect_with(BitWord * bits, const BitWord * other, unsigned n_words) -> void
+    {
+        for (unsigned i = 0 ; i < n_words ; i += 8) {
+            __mmask8 m = n_words - i >= 8 ? 0xff : avx512_tail_mask(n_words - i);
+            __m512i a = _mm512_maskz_loadu_epi64(m, bits + i);
+            __m512i b = _mm512_maskz_loadu_epi64(m, other + i);
+            _mm512_mask_storeu_epi64(bits + i, m, _mm512_and_si512(a, b));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    auto avx512_intersect_with_complement(BitWord * bits, const BitWord * other, unsigned n_words) -> void
+    {
+        for (unsigned i = 0 ; i < n_words ; i += 8) {
+            __mmask8 m = n_words - i >= 8 ? 0xff : avx512_tail_mask(n_words - i);
+            __m512i a = _mm512_maskz_loadu_epi64(m, bits + i);
+            __m512i b = _mm512_maskz_loadu_epi64(m, other + i);
+            _mm512_mask_storeu_epi64(bits + i, m, _mm512_andnot_si512(b, a));
+        }
+    }
+
+    __attribute__((target("avx512f,avx512vpopcntdq")))
+    auto avx512_popcount(const BitWord * bits, unsigned n_words) -> unsigned
+    {
+        __m512i totals = _mm512_setzero_si512();
+        for (unsigned i = 0 ; i < n_words ; i += 8) {
+            __mmask8 m = n_words - i >= 8 ? 0xff : avx512_tail_mask(n_words - i);
+            totals = _mm512_add_epi64(totals, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(m, bits + i)));
+        }
+
+        return _mm512_reduce_add_epi64(totals);
+    }
+
+    __attribute__((target("avx512f")))
+    auto avx512_empty(const BitWord * bits, unsigned n_words) -> bool
+    {
+        for (unsigned i = 0 ; i < n_words ; i += 8) {
+            __mmask8 m = n_words - i >= 8 ? 0xff : avx512_tail_mask(n_words - i);
+            __m512i v = _mm512_maskz_loadu_epi64(m, bits + i);
+            if (0 != _mm512_test_epi64_mask(v, v))
+                return false;
+        }
+
+        return true;
+    }
+
+    __attribute__((target("avx512f")))
+    auto avx512_first_set_bit(const BitWord * bits, unsigned n_words) -> int
+    {
+        for (unsigned i = 0 ; i < n_words ; i += 8) {
+            __mmask8 m = n_words - i >= 8 ? 0xff : avx512_tail_mask(n_words - i);
+            __m512i v = _mm512_maskz_loadu_epi64(m, bits + i);
+
+            /* One bit for each word which isn't zero. */
+            unsigned non_zeroes = _mm512_test_epi64_mask(v, v);
+            if (0 != non_zeroes) {
+                i += __builtin_ctz(non_zeroes);
+                return i * bits_per_word + __builtin_ctzll(bits[i]);
+            }
+        }
+
+        return -1;
+    }
+#endif
+
+    const BitKernels scalar_kernels = { "scalar", scalar_intersect_with, scalar_intersect_with_complement,
+        scalar_popcount, scalar_empty, scalar_first_set_bit };
+
+    auto select_bit_kernels() -> BitKernels
+    {
+        /* Best first. */
+        BitKernels candidates[4];
+        int n_candidates = 0;
+
+#ifdef PARASOLS_BIT_KERNELS_X86
+        __builtin_cpu_init();
+
+        bool have_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+        bool have_avx512 = have_avx2 && __builtin_cpu_supports("avx512f");
+
+        if (have_avx512 && __builtin_cpu_supports("avx512vpopcntdq"))
+            candidates[n_candidates++] = { "avx512", avx512_intersect_with, avx512_intersect_with_complement,
+                avx512_popcount, avx512_empty, avx512_first_set_bit };
+
+        /* Without VPOPCNTDQ, we still have AVX2 for counting. */
+        if (have_avx512)
+            candidates[n_candidates++] = { "avx512f", avx512_intersect_with, avx512_intersect_with_complement,
+                avx2_popcount, avx512_empty, avx512_first_set_bit };
+
+        if (have_avx2)
+            candidates[n_candidates++] = { "avx2", avx2_intersect_with, avx2_intersect_with_complement,
+                avx2_popcount, avx2_empty, avx2_first_set_bit };
+#endif
+
+        candidates[n_candidates++] = scalar_kernels;
+
+        const char * wanted = std::getenv("PARASOLS_BIT_KERNELS");
+        if (wanted)
+            for (int c = 0 ; c < n_candidates ; ++c)
+                if (0 == std::strcmp(wanted, candidates[c].name))
+                    return candidates[c];
+
+        return candidates[0];
+    }
+
+    /* Does the choosing, during static initialisation. */
+    struct BitKernelsSelector
+    {
+        BitKernelsSelector()
+        {
+            bit_kernels = select_bit_kernels();
+        }
+    } bit_kernels_selector;
+}
+
+BitKernels parasols::bit_kernels = { "scalar", scalar_intersect_with, scalar_intersect_with_complement,
+    scalar_popcount, scalar_empty, scalar_first_set_bit };
+
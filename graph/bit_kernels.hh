@@ -0,0 +1,48 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_BIT_KERNELS_HH
+#define PARASOLS_GUARD_GRAPH_BIT_KERNELS_HH 1
+
+namespace parasols
+{
+    /// We'll use an array of unsigned long longs to represent our bits.
+    using BitWord = unsigned long long;
+
+    /// Number of bits per word.
+    static const constexpr int bits_per_word = sizeof(BitWord) * 8;
+
+    /**
+     * Whole-bitset loops, for big FixedBitSets. There is one of these for
+     * each instruction set we have kernels for, and we pick the best one the
+     * CPU supports at startup, so that we use AVX2 or AVX-512 even if we
+     * weren't compiled for them.
+     */
+    struct BitKernels
+    {
+        /// Which instruction set this is for.
+        const char * name;
+
+        void (* intersect_with)(BitWord * bits, const BitWord * other, unsigned n_words);
+        void (* intersect_with_complement)(BitWord * bits, const BitWord * other, unsigned n_words);
+        unsigned (* popcount)(const BitWord * bits, unsigned n_words);
+        bool (* empty)(const BitWord * bits, unsigned n_words);
+        int (* first_set_bit)(const BitWord * bits, unsigned n_words);
+    };
+
+    /**
+     * FixedBitSets with at least this many words use bit_kernels. Smaller
+     * ones use inline loops, since for them the cost of calling through a
+     * pointer outweighs anything we could gain.
+     */
+    static const constexpr unsigned bit_kernels_min_words = 64;
+
+    /**
+     * The kernels we are using. These are the scalar ones until static
+     * initialisation is done, and then the best ones the CPU supports,
+     * unless the PARASOLS_BIT_KERNELS environment variable names some other
+     * supported kernels (for example "scalar").
+     */
+    extern BitKernels bit_kernels;
+}
+
+#endif
@@ -13,6 +13,8 @@ auto parasols::complement(const Graph & graph) -> Graph
             if (i != j && ! graph.adjacent(i, j))
                 result.add_edge(i, j);
 
+    result.set_vertex_labels(graph.vertex_labels());
+
     return result;
 }
 
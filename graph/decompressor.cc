@@ -0,0 +1,297 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/decompressor.hh>
+
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+#include <unistd.h>
+#include <zlib.h>
+
+#ifdef PARASOLS_HAVE_ZSTD
+#  include <zstd.h>
+#endif
+
+using namespace parasols;
+
+namespace
+{
+    /* How much we decompress before handing it over, and how many such
+     * chunks we hold on to if the reader falls behind. */
+    const constexpr std::size_t chunk_size = 1 << 20;
+    const constexpr std::size_t max_chunks = 8;
+
+    /* How much compressed input we read or hand over at once. Also keeps us
+     * well within the range of zlib's unsigned ints. */
+    const constexpr std::size_t input_size = 1 << 20;
+
+    auto is_gzip(const char * data, std::size_t size) -> bool
+    {
+        return size >= 2 && '\x1f' == data[0] && '\x8b' == data[1];
+    }
+
+    auto is_zstd(const char * data, std::size_t size) -> bool
+    {
+        return size >= 4 && 0 == std::memcmp(data, "\x28\xb5\x2f\xfd", 4);
+    }
+}
+
+auto Decompressor::is_compressed(const char * data, std::size_t size) -> bool
+{
+    return is_gzip(data, size) || is_zstd(data, size);
+}
+
+Decompressor::Decompressor(const std::string & filename, std::unique_ptr<MappedFile> && mapped) :
+    _filename(filename),
+    _mapped(std::move(mapped)),
+    _fd(-1),
+    _zstd(is_zstd(_mapped->data(), _mapped->size()))
+{
+#ifndef PARASOLS_HAVE_ZSTD
+    if (_zstd)
+        throw GraphFileError{ _filename, "file is zstd compressed, but we were built without zstd support" };
+#endif
+
+    _thread = std::thread([this] { _run(); });
+}
+
+Decompressor::Decompressor(const std::string & filename, int fd, std::string && prefix) :
+    _filename(filename),
+    _fd(fd),
+    _prefix(std::move(prefix)),
+    _zstd(is_zstd(_prefix.data(), _prefix.size()))
+{
+#ifndef PARASOLS_HAVE_ZSTD
+    if (_zstd)
+        throw GraphFileError{ _filename, "file is zstd compressed, but we were built without zstd support" };
+#endif
+
+    _input.resize(input_size);
+    _thread = std::thread([this] { _run(); });
+}
+
+Decompressor::~Decompressor()
+{
+    {
+        std::unique_lock<std::mutex> guard(_mutex);
+        _stop = true;
+        _cond.notify_all();
+    }
+
+    if (_thread.joinable())
+        _thread.join();
+}
+
+auto Decompressor::_next_input(const char * & data, std::size_t & size) -> bool
+{
+    if (_mapped) {
+        if (_mapped_used == _mapped->size())
+            return false;
+
+        data = _mapped->data() + _mapped_used;
+        size = std::min(input_size, _mapped->size() - _mapped_used);
+        _mapped_used += size;
+        return true;
+    }
+
+    if (! _prefix_used) {
+        _prefix_used = true;
+        if (! _prefix.empty()) {
+            data = _prefix.data();
+            size = _prefix.size();
+            return true;
+        }
+    }
+
+    while (true) {
+        auto n = ::read(_fd, _input.data(), _input.size());
+        if (-1 == n) {
+            if (EINTR == errno)
+                continue;
+            throw GraphFileError{ _filename, "error reading file" };
+        }
+        else if (0 == n)
+            return false;
+
+        data = _input.data();
+        size = n;
+        return true;
+    }
+}
+
+auto Decompressor::_push(std::vector<char> && chunk) -> bool
+{
+    std::unique_lock<std::mutex> guard(_mutex);
+
+    /* Don't get too far ahead of the reader. */
+    while (_chunks.size() >= max_chunks && ! _stop)
+        _cond.wait(guard);
+
+    if (_stop)
+        return false;
+
+    _chunks.push_back(std::move(chunk));
+    _cond.notify_all();
+    return true;
+}
+
+auto Decompressor::_take() -> bool
+{
+    std::unique_lock<std::mutex> guard(_mutex);
+
+    while (_chunks.empty() && ! _done)
+        _cond.wait(guard);
+
+    if (_chunks.empty()) {
+        if (_error)
+            std::rethrow_exception(_error);
+        return false;
+    }
+
+    _current = std::move(_chunks.front());
+    _current_used = 0;
+    _chunks.pop_front();
+
+    /* The thread may be waiting for space. */
+    _cond.notify_all();
+
+    return true;
+}
+
+auto Decompressor::_run() -> void
+{
+    try {
+        if (_zstd)
+            _run_zstd();
+        else
+            _run_gzip();
+    }
+    catch (...) {
+        std::unique_lock<std::mutex> guard(_mutex);
+        _error = std::current_exception();
+    }
+
+    std::unique_lock<std::mutex> guard(_mutex);
+    _done = true;
+    _cond.notify_all();
+}
+
+auto Decompressor::_run_gzip() -> void
+{
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+
+    /* 32 means work out whether it's gzip or zlib from the header. */
+    if (Z_OK != inflateInit2(&stream, 15 + 32))
+        throw GraphFileError{ _filename, "unable to start decompressing file" };
+
+    std::unique_ptr<z_stream, int (*) (z_stream *)> cleanup(&stream, inflateEnd);
+
+    std::vector<char> chunk(chunk_size);
+    std::size_t filled = 0;
+    bool member_ended = true;
+
+    const char * data;
+    std::size_t size;
+    while (_next_input(data, size)) {
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        stream.avail_in = size;
+
+        do {
+            /* gzip files may be several members one after another. */
+            if (member_ended && 0 != stream.avail_in) {
+                inflateReset(&stream);
+                member_ended = false;
+            }
+
+            stream.next_out = reinterpret_cast<Bytef *>(chunk.data() + filled);
+            stream.avail_out = chunk_size - filled;
+
+            int result = inflate(&stream, Z_NO_FLUSH);
+            if (Z_STREAM_END == result)
+                member_ended = true;
+            else if (Z_OK != result && Z_BUF_ERROR != result)
+                throw GraphFileError{ _filename, "error decompressing file" };
+
+            filled = chunk_size - stream.avail_out;
+            if (chunk_size == filled) {
+                if (! _push(std::move(chunk)))
+                    return;
+                chunk.resize(chunk_size);
+                filled = 0;
+            }
+        } while (0 != stream.avail_in || 0 == stream.avail_out);
+    }
+
+    if (! member_ended)
+        throw GraphFileError{ _filename, "compressed file is truncated" };
+
+    if (0 != filled) {
+        chunk.resize(filled);
+        _push(std::move(chunk));
+    }
+}
+
+auto Decompressor::_run_zstd() -> void
+{
+#ifdef PARASOLS_HAVE_ZSTD
+    std::unique_ptr<ZSTD_DStream, std::size_t (*) (ZSTD_DStream *)> stream(ZSTD_createDStream(), ZSTD_freeDStream);
+    if ((! stream) || ZSTD_isError(ZSTD_initDStream(stream.get())))
+        throw GraphFileError{ _filename, "unable to start decompressing file" };
+
+    std::vector<char> chunk(chunk_size);
+    std::size_t filled = 0;
+    bool frame_ended = true, more_output = false;
+
+    const char * data;
+    std::size_t size;
+    while (_next_input(data, size)) {
+        ZSTD_inBuffer in{ data, size, 0 };
+
+        do {
+            ZSTD_outBuffer out{ chunk.data(), chunk_size, filled };
+
+            /* Also moves on to the next frame, if there is one. */
+            std::size_t result = ZSTD_decompressStream(stream.get(), &out, &in);
+            if (ZSTD_isError(result))
+                throw GraphFileError{ _filename, "error decompressing file" };
+            frame_ended = (0 == result);
+
+            /* If we filled the chunk, there may be more to come. */
+            filled = out.pos;
+            more_output = (chunk_size == filled);
+            if (more_output) {
+                if (! _push(std::move(chunk)))
+                    return;
+                chunk.resize(chunk_size);
+                filled = 0;
+            }
+        } while (in.pos != in.size || more_output);
+    }
+
+    if (! frame_ended)
+        throw GraphFileError{ _filename, "compressed file is truncated" };
+
+    if (0 != filled) {
+        chunk.resize(filled);
+        _push(std::move(chunk));
+    }
+#endif
+}
+
+auto Decompressor::read(char * dest, std::size_t n) -> std::size_t
+{
+    std::size_t k = 0;
+    while (k < n) {
+        if (_current_used == _current.size() && ! _take())
+            break;
+
+        std::size_t m = std::min(n - k, _current.size() - _current_used);
+        std::memcpy(dest + k, _current.data() + _current_used, m);
+        _current_used += m;
+        k += m;
+    }
+
+    return k;
+}
@@ -0,0 +1,102 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_DECOMPRESSOR_HH
+#define PARASOLS_GUARD_GRAPH_DECOMPRESSOR_HH 1
+
+#include <graph/graph_file_error.hh>
+#include <graph/mapped_file.hh>
+
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <exception>
+#include <cstddef>
+
+namespace parasols
+{
+    /**
+     * Decompresses a gzip file (or a zstd file, if we were built with zstd
+     * support) in a separate thread, so that decompression overlaps with
+     * whatever is reading the decompressed data.
+     *
+     * The thread keeps at most a few chunks of decompressed data ready, so
+     * memory use doesn't depend upon the size of the file.
+     */
+    class Decompressor
+    {
+        private:
+            const std::string _filename;
+            std::unique_ptr<MappedFile> _mapped;
+            const int _fd;
+            std::string _prefix;
+            bool _zstd = false;
+
+            /* Compressed input, when reading from _fd. */
+            std::vector<char> _input;
+            std::size_t _mapped_used = 0;
+            bool _prefix_used = false;
+
+            /* What read() is working through. */
+            std::vector<char> _current;
+            std::size_t _current_used = 0;
+
+            /* These protect and watch all subsequent private members. */
+            std::mutex _mutex;
+            std::condition_variable _cond;
+
+            std::list<std::vector<char> > _chunks;
+            bool _done = false, _stop = false;
+            std::exception_ptr _error;
+
+            std::thread _thread;
+
+            auto _next_input(const char * & data, std::size_t & size) -> bool;
+            auto _push(std::vector<char> && chunk) -> bool;
+            auto _take() -> bool;
+
+            auto _run() -> void;
+            auto _run_gzip() -> void;
+            auto _run_zstd() -> void;
+
+        public:
+            /**
+             * Does this look like the start of something compressed? We may
+             * need up to four bytes to be sure.
+             */
+            static auto is_compressed(const char * data, std::size_t size) -> bool;
+
+            /**
+             * Decompress a mapped file.
+             *
+             * \throw GraphFileError
+             */
+            Decompressor(const std::string & filename, std::unique_ptr<MappedFile> && mapped);
+
+            /**
+             * Decompress prefix, and then whatever else can be read from fd,
+             * which we don't close.
+             *
+             * \throw GraphFileError
+             */
+            Decompressor(const std::string & filename, int fd, std::string && prefix);
+
+            ~Decompressor();
+
+            Decompressor(const Decompressor &) = delete;
+            Decompressor & operator= (const Decompressor &) = delete;
+
+            /**
+             * Read up to n bytes of decompressed data, returning how many we
+             * got, which is only less than n at the end.
+             *
+             * \throw GraphFileError
+             */
+            auto read(char * dest, std::size_t n) -> std::size_t;
+    };
+}
+
+#endif
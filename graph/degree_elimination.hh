@@ -0,0 +1,185 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_DEGREE_ELIMINATION_HH
+#define PARASOLS_GUARD_GRAPH_DEGREE_ELIMINATION_HH 1
+
+#include <graph/graph.hh>
+
+#include <vector>
+#include <algorithm>
+
+namespace parasols
+{
+    /**
+     * Vertices grouped by their current degree, so that finding a vertex of
+     * minimum or maximum degree and lowering a vertex's degree are both
+     * cheap. Degrees may only go down once vertices have been removed.
+     */
+    class DegreeBuckets
+    {
+        private:
+            std::vector<int> _head, _next, _prev;
+            int _lowest, _highest;
+
+        public:
+            DegreeBuckets(int size, int max_degree) :
+                _head(max_degree + 1, -1),
+                _next(size, -1),
+                _prev(size, -1),
+                _lowest(max_degree + 1),
+                _highest(0)
+            {
+            }
+
+            auto insert(int v, int d) -> void
+            {
+                _prev[v] = -1;
+                _next[v] = _head[d];
+                if (-1 != _head[d])
+                    _prev[_head[d]] = v;
+                _head[d] = v;
+                _lowest = std::min(_lowest, d);
+                _highest = std::max(_highest, d);
+            }
+
+            auto erase(int v, int d) -> void
+            {
+                if (-1 != _prev[v])
+                    _next[_prev[v]] = _next[v];
+                else
+                    _head[d] = _next[v];
+
+                if (-1 != _next[v])
+                    _prev[_next[v]] = _prev[v];
+            }
+
+            /**
+             * The lowest non-empty degree. Must not be called when empty.
+             */
+            auto lowest() -> int
+            {
+                while (-1 == _head[_lowest])
+                    ++_lowest;
+                return _lowest;
+            }
+
+            /**
+             * The highest non-empty degree. Must not be called when empty.
+             */
+            auto highest() -> int
+            {
+                while (-1 == _head[_highest])
+                    --_highest;
+                return _highest;
+            }
+
+            template <typename F_>
+            auto for_each(int d, const F_ & f) const -> void
+            {
+                for (int v = _head[d] ; -1 != v ; v = _next[v])
+                    f(v);
+            }
+    };
+
+    /**
+     * Removes vertices one at a time, keeping track of the vertices we have
+     * not yet removed, their current degrees, and the order in which we
+     * removed the others. Used by the degeneracy style orderings.
+     */
+    struct DegreeElimination
+    {
+        const Graph & graph;
+        std::vector<BitWord> remaining;
+        std::vector<int> degrees;
+        DegreeBuckets buckets;
+        std::vector<int> result;
+
+        DegreeElimination(const Graph & g, const std::vector<int> & p) :
+            graph(g),
+            remaining(g.words_per_row(), 0),
+            degrees(g.size(), 0),
+            buckets(g.size(), max_degree(g, p))
+        {
+            for (auto & v : p) {
+                remaining[v / bits_per_word] |= (BitWord{ 1 } << (v % bits_per_word));
+                degrees[v] = graph.degree(v);
+                buckets.insert(v, degrees[v]);
+            }
+
+            result.reserve(p.size());
+        }
+
+        static auto max_degree(const Graph & g, const std::vector<int> & p) -> int
+        {
+            int result = 0;
+            for (auto & v : p)
+                result = std::max(result, g.degree(v));
+            return result;
+        }
+
+        template <typename F_>
+        auto for_each_remaining_neighbour(int v, const F_ & f) const -> void
+        {
+            const BitWord * row = graph.neighbourhood_words(v);
+            for (int w = 0 ; w < graph.words_per_row() ; ++w) {
+                BitWord bits = row[w] & remaining[w];
+                while (0 != bits) {
+                    int b = __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    f(w * bits_per_word + b);
+                }
+            }
+        }
+
+        /**
+         * Remove v, lowering the degree of each of its remaining neighbours,
+         * which are returned in lowered.
+         */
+        auto remove(int v, std::vector<int> & lowered) -> void
+        {
+            result.push_back(v);
+            buckets.erase(v, degrees[v]);
+            remaining[v / bits_per_word] &= ~(BitWord{ 1 } << (v % bits_per_word));
+
+            lowered.clear();
+            for_each_remaining_neighbour(v, [&] (int u) {
+                    buckets.erase(u, degrees[u]);
+                    buckets.insert(u, --degrees[u]);
+                    lowered.push_back(u);
+                    });
+        }
+
+        /**
+         * Pick the remaining vertex of lowest degree, breaking ties using
+         * better(a, b).
+         */
+        template <typename F_>
+        auto pick_lowest(const F_ & better) -> int
+        {
+            return _pick(buckets.lowest(), better);
+        }
+
+        /**
+         * Pick the remaining vertex of highest degree, breaking ties using
+         * better(a, b).
+         */
+        template <typename F_>
+        auto pick_highest(const F_ & better) -> int
+        {
+            return _pick(buckets.highest(), better);
+        }
+
+        template <typename F_>
+        auto _pick(int d, const F_ & better) const -> int
+        {
+            int best = -1;
+            buckets.for_each(d, [&] (int v) {
+                    if (-1 == best || better(v, best))
+                        best = v;
+                    });
+            return best;
+        }
+    };
+}
+
+#endif
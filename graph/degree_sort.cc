@@ -1,12 +1,57 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 #include <graph/degree_sort.hh>
+#include <graph/degree_elimination.hh>
+#include <graph/permute_graph.hh>
 
 #include <algorithm>
 #include <iterator>
 
 using namespace parasols;
 
+namespace
+{
+    /**
+     * For each vertex, the sum of the degrees of its neighbours. Rather than
+     * visiting each neighbour, we split the degrees into bit planes, and
+     * popcount each row against each plane.
+     */
+    auto calculate_exdegrees(const Graph & graph) -> std::vector<long long>
+    {
+        int words = graph.words_per_row(), max_degree = 0;
+        for (int v = 0 ; v < graph.size() ; ++v)
+            max_degree = std::max(max_degree, graph.degree(v));
+
+        int n_planes = 0;
+        while (0 != (max_degree >> n_planes))
+            ++n_planes;
+
+        std::vector<BitWord> planes(std::size_t(n_planes) * words, 0);
+        for (int v = 0 ; v < graph.size() ; ++v)
+            for (int b = 0 ; b < n_planes ; ++b)
+                if (graph.degree(v) & (1 << b))
+                    planes[std::size_t(b) * words + v / bits_per_word] |= (BitWord{ 1 } << (v % bits_per_word));
+
+        std::vector<long long> exdegrees(graph.size());
+        for_each_row_range(graph.size(), [&] (int begin, int end) {
+                for (int v = begin ; v < end ; ++v) {
+                    const BitWord * row = graph.neighbourhood_words(v);
+                    long long exdegree = 0;
+                    for (int b = 0 ; b < n_planes ; ++b) {
+                        const BitWord * plane = &planes[std::size_t(b) * words];
+                        long long count = 0;
+                        for (int w = 0 ; w < words ; ++w)
+                            count += __builtin_popcountll(row[w] & plane[w]);
+                        exdegree += count << b;
+                    }
+                    exdegrees[v] = exdegree;
+                }
+            });
+
+        return exdegrees;
+    }
+}
+
 auto parasols::degree_sort(const Graph & graph, std::vector<int> & p, bool reverse) -> void
 {
     // pre-calculate degrees
@@ -26,11 +71,7 @@ auto parasols::exdegree_sort(const Graph & graph, std::vector<int> & p, bool rev
     std::transform(p.begin(), p.end(), std::back_inserter(degrees),
             [&] (int v) { return graph.degree(v); });
 
-    std::vector<int> exdegrees((graph.size()));
-    for (int i = 0 ; i < graph.size() ; ++i)
-        for (int j = 0 ; j < graph.size() ; ++j)
-            if (graph.adjacent(i, j))
-                exdegrees[i] += degrees[j];
+    auto exdegrees = calculate_exdegrees(graph);
 
     // sort on degree
     std::sort(p.begin(), p.end(),
@@ -43,34 +84,27 @@ auto parasols::exdegree_sort(const Graph & graph, std::vector<int> & p, bool rev
 
 auto parasols::dynexdegree_sort(const Graph & graph, std::vector<int> & p, bool reverse) -> void
 {
-    // pre-calculate degrees and exdegrees
-    std::vector<int> degrees;
-    std::transform(p.begin(), p.end(), std::back_inserter(degrees),
-            [&] (int v) { return graph.degree(v); });
-
-    std::vector<int> exdegrees((graph.size()));
-    for (int i = 0 ; i < graph.size() ; ++i)
-        for (int j = 0 ; j < graph.size() ; ++j)
-            if (graph.adjacent(i, j))
-                exdegrees[i] += degrees[j];
-
-    auto unsorted = p.begin(), unsorted_end = p.end();
-
-    while (unsorted != unsorted_end) {
-        // sort on degree
-        std::sort(unsorted, unsorted_end,
-                [&] (int a, int b) { return (! reverse) ^ (
-                    (degrees[a] < degrees[b]) ||
-                    (degrees[a] == degrees[b] && exdegrees[a] < exdegrees[b]) ||
-                    (degrees[a] == degrees[b] && exdegrees[a] == exdegrees[b] && a > b)
-                    ); });
-
-        for (int i = 0 ; i < graph.size() ; ++i)
-            if (graph.adjacent(i, *prev(unsorted_end)))
-                --degrees[i];
-
-        --unsorted_end;
+    // exdegrees are static, but degrees change as we go
+    auto exdegrees = calculate_exdegrees(graph);
+
+    // repeatedly take the last vertex in the order from what remains,
+    // working from the back
+    DegreeElimination e{ graph, p };
+    std::vector<int> lowered;
+    lowered.reserve(p.size());
+
+    for (unsigned i = 0 ; i < p.size() ; ++i) {
+        if (reverse)
+            e.remove(e.pick_highest([&] (int a, int b) { return
+                        (exdegrees[a] > exdegrees[b]) ||
+                        (exdegrees[a] == exdegrees[b] && a < b); }), lowered);
+        else
+            e.remove(e.pick_lowest([&] (int a, int b) { return
+                        (exdegrees[a] < exdegrees[b]) ||
+                        (exdegrees[a] == exdegrees[b] && a > b); }), lowered);
     }
+
+    std::copy(e.result.rbegin(), e.result.rend(), p.begin());
 }
 
 auto parasols::none_sort(const Graph &, std::vector<int> & p, bool reverse) -> void
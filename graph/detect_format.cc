@@ -0,0 +1,125 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/detect_format.hh>
+#include <graph/dimacs.hh>
+#include <graph/net.hh>
+#include <graph/metis.hh>
+#include <graph/mivia.hh>
+#include <graph/adj.hh>
+#include <graph/lad.hh>
+#include <graph/binary.hh>
+
+using namespace parasols;
+
+namespace
+{
+    /**
+     * We don't look any further into a file than this.
+     */
+    const constexpr std::size_t detect_bytes = 1 << 16;
+
+    /**
+     * Does this look like binary data, rather than text?
+     */
+    auto looks_binary(Tokeniser text) -> bool
+    {
+        while (! text.at_end()) {
+            char c = text.peek();
+            if (c >= '\0' && c < ' ' && '\n' != c && ! is_space(c))
+                return true;
+            text.skip_char(c);
+        }
+        return false;
+    }
+
+    /**
+     * How many numbers are on this line, or -1 if there's anything else?
+     */
+    auto count_numbers(Tokeniser line) -> int
+    {
+        int result = 0, n;
+        while (line.skip_spaces(), ! line.at_end()) {
+            if (! line.read_number(n))
+                return -1;
+            ++result;
+        }
+        return result;
+    }
+}
+
+auto parasols::detect_format(const InputFile & input) -> std::string
+{
+    auto text = input.peek(detect_bytes);
+
+    if (text.skip_word("PSLGRAPH"))
+        return "binary";
+
+    if (looks_binary(text))
+        return "mivia";
+
+    /* Look at the first line with anything on it. Net files can start with
+     * comments that look like metis comments, so we have to go on until we
+     * find something else. */
+    bool seen_percent = false;
+    while (! text.at_end()) {
+        auto line = text.next_line();
+        line.skip_trailing_char('\r');
+        line.skip_spaces();
+        if (line.at_end())
+            continue;
+
+        switch (line.peek()) {
+            case 'c':
+            case 'p':
+                return "dimacs";
+
+            case '*':
+                return "net";
+
+            case '[':
+                return "adj";
+
+            case '%':
+                seen_percent = true;
+                continue;
+        }
+
+        int n = count_numbers(line);
+        if (1 == n && ! seen_percent)
+            return "lad";
+        else if (n >= 2 && n <= 4)
+            return "metis";
+        else if (n == -1) {
+            /* net files describe their vertices with a number then a quoted
+             * name */
+            int x;
+            if (line.read_number(x) && line.skip_spaces() && line.skip_char('"'))
+                return "net";
+        }
+
+        break;
+    }
+
+    throw GraphFileError{ input.filename(), "cannot work out what format this file is in" };
+}
+
+auto parasols::read_auto(const std::string & filename, const GraphOptions & options) -> Graph
+{
+    InputFile input{ filename };
+    auto format = detect_format(input);
+
+    if ("binary" == format)
+        return read_binary(input, options);
+    else if ("mivia" == format)
+        return read_mivia(input, options);
+    else if ("dimacs" == format)
+        return read_dimacs(input, options);
+    else if ("net" == format)
+        return read_net(input, options);
+    else if ("adj" == format)
+        return read_adj(input, options);
+    else if ("metis" == format)
+        return read_metis(input, options);
+    else
+        return read_lad(input, options);
+}
@@ -0,0 +1,32 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_DETECT_FORMAT_HH
+#define PARASOLS_GUARD_GRAPH_DETECT_FORMAT_HH 1
+
+#include <graph/graph.hh>
+#include <graph/input_file.hh>
+
+#include <string>
+
+namespace parasols
+{
+    /**
+     * Work out what format a graph file is in, from the start of it, without
+     * using any of it up. We can tell binary, mivia, dimacs, net, adj, metis
+     * and lad files apart. Pairs files look too much like metis and lad
+     * files, so we never guess them.
+     *
+     * \throw GraphFileError
+     */
+    auto detect_format(const InputFile & input) -> std::string;
+
+    /**
+     * Read a graph file in whatever format detect_format says it is. Works
+     * for streams as well as regular files.
+     *
+     * \throw GraphFileError
+     */
+    auto read_auto(const std::string & filename, const GraphOptions & options) -> Graph;
+}
+
+#endif
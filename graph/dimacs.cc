@@ -3,59 +3,188 @@
 #include <graph/dimacs.hh>
 #include <graph/graph.hh>
 #include <graph/graph_file_error.hh>
-#include <boost/regex.hpp>
-#include <fstream>
+#include <graph/input_file.hh>
+#include <graph/tokeniser.hh>
 
 using namespace parasols;
 
-auto parasols::read_dimacs(const std::string & filename, const GraphOptions & options) -> Graph
+namespace
 {
-    Graph result(0, true);
+    enum class LineKind
+    {
+        Empty,
+        Comment,
+        Problem,
+        Edge,
+        Unparseable
+    };
+
+    /**
+     * Work out what a line is, and extract its numbers. Accepts exactly what
+     * the old regular expressions accepted:
+     *
+     *     c(\s.*)?
+     *     p\s+(edge|col)\s+(\d+)\s+(\d+)?\s*
+     *     e\s+(\d+)\s+(\d+)\s*
+     */
+    auto classify_line(Tokeniser line, int & x, int & y) -> LineKind
+    {
+        if (line.at_end())
+            return LineKind::Empty;
 
-    std::ifstream infile{ filename };
-    if (! infile)
-        throw GraphFileError{ filename, "unable to open file" };
-
-    std::string line;
-    while (std::getline(infile, line)) {
-        if (line.empty())
-            continue;
-
-        /* Lines are comments, a problem description (contains the number of
-         * vertices), or an edge. */
-        static const boost::regex
-            comment{ R"(c(\s.*)?)" },
-            problem{ R"(p\s+(edge|col)\s+(\d+)\s+(\d+)?\s*)" },
-            edge{ R"(e\s+(\d+)\s+(\d+)\s*)" };
-
-        boost::smatch match;
-        if (regex_match(line, match, comment)) {
-            /* Comment, ignore */
+        if (line.skip_char('c')) {
+            if (line.at_end() || line.skip_spaces())
+                return LineKind::Comment;
         }
-        else if (regex_match(line, match, problem)) {
-            /* Problem. Specifies the size of the graph. Must happen exactly
-             * once. */
-            if (0 != result.size())
-                throw GraphFileError{ filename, "multiple 'p' lines encountered" };
-            result.resize(std::stoi(match.str(2)));
+        else if (line.skip_char('p')) {
+            if (line.skip_spaces()
+                    && (line.skip_word("edge") || line.skip_word("col"))
+                    && line.skip_spaces()
+                    && line.read_number(x)
+                    && line.skip_spaces()) {
+                line.read_number(y);
+                line.skip_spaces();
+                if (line.at_end())
+                    return LineKind::Problem;
+            }
         }
-        else if (regex_match(line, match, edge)) {
-            /* An edge. DIMACS files are 1-indexed. We assume we've already had
-             * a problem line (if not our size will be 0, so we'll throw). */
-            int a{ std::stoi(match.str(1)) }, b{ std::stoi(match.str(2)) };
-            if (0 == a || 0 == b || a > result.size() || b > result.size())
-                throw GraphFileError{ filename, "line '" + line + "' edge index out of bounds" };
-            else if (a == b && ! test(options, GraphOptions::AllowLoops))
-                throw GraphFileError{ filename, "line '" + line + "' contains a loop on vertex " + std::to_string(a) };
-            result.add_edge(a - 1, b - 1);
+        else if (line.skip_char('e')) {
+            if (line.skip_spaces()
+                    && line.read_number(x)
+                    && line.skip_spaces()
+                    && line.read_number(y)) {
+                line.skip_spaces();
+                if (line.at_end())
+                    return LineKind::Edge;
+            }
         }
-        else
-            throw GraphFileError{ filename, "cannot parse line '" + line + "'" };
+
+        return LineKind::Unparseable;
     }
 
-    if (! infile.eof())
-        throw GraphFileError{ filename, "error reading file" };
+    /**
+     * Parse a chunk of edge lines. Every line must be an edge, a comment or
+     * empty, since the problem line has already been seen.
+     */
+    auto parse_chunk(const char * begin, const char * end, int size, const GraphOptions & options, ParsedEdges & chunk) -> void
+    {
+        Tokeniser text{ begin, end };
+        while (! text.at_end()) {
+            auto line = text.next_line();
+
+            int a = 0, b = 0;
+            switch (classify_line(line, a, b)) {
+                case LineKind::Empty:
+                case LineKind::Comment:
+                    break;
+
+                case LineKind::Problem:
+                    chunk.error = "multiple 'p' lines encountered";
+                    return;
+
+                case LineKind::Edge:
+                    if (0 == a || 0 == b || a > size || b > size) {
+                        chunk.error = "line '" + line.rest() + "' edge index out of bounds";
+                        return;
+                    }
+                    else if (a == b && ! test(options, GraphOptions::AllowLoops)) {
+                        chunk.error = "line '" + line.rest() + "' contains a loop on vertex " + std::to_string(a);
+                        return;
+                    }
+                    chunk.edges.emplace_back(a - 1, b - 1);
+                    break;
+
+                case LineKind::Unparseable:
+                    chunk.error = "cannot parse line '" + line.rest() + "'";
+                    return;
+            }
+        }
+    }
+
+    /**
+     * Parse a DIMACS file, passing the size and then each edge to the
+     * supplied callbacks.
+     *
+     * The header (everything up to the first edge) is read sequentially. The
+     * rest of each block of the file is split into chunks which may be
+     * parsed in parallel, and then the edges are handed over in file order.
+     */
+    template <typename SetSize_, typename AddEdge_>
+    auto read_dimacs_edges(InputFile & input, const GraphOptions & options,
+            const SetSize_ & set_size, const AddEdge_ & add_edge) -> void
+    {
+        const std::string & filename = input.filename();
+        Tokeniser text{ input.begin(), input.end() };
+
+        int size = 0;
+
+        /* Header. Comments, and a problem description (contains the number of
+         * vertices), which must happen exactly once. */
+        while (input.refill(text) && 'e' != text.peek()) {
+            auto line = text.next_line();
+
+            int n = 0, m = 0;
+            switch (classify_line(line, n, m)) {
+                case LineKind::Empty:
+                case LineKind::Comment:
+                    break;
+
+                case LineKind::Problem:
+                    if (0 != size)
+                        throw GraphFileError{ filename, "multiple 'p' lines encountered" };
+                    size = n;
+                    set_size(size);
+                    break;
+
+                case LineKind::Edge:
+                case LineKind::Unparseable:
+                    throw GraphFileError{ filename, "cannot parse line '" + line.rest() + "'" };
+            }
+        }
+
+        /* Edges. DIMACS files are 1-indexed. If we haven't had a problem line
+         * our size will be 0, so we'll throw. */
+        input.for_each_remaining_block(text, [&] (const char * begin, const char * end) {
+                auto chunks = parse_chunks<ParsedEdges>(begin, end,
+                        [&] (const char * chunk_begin, const char * chunk_end, ParsedEdges & chunk) {
+                            parse_chunk(chunk_begin, chunk_end, size, options, chunk);
+                        });
+
+                /* Report the first problem in the block, if there is one. */
+                for (auto & chunk : chunks)
+                    if (! chunk.error.empty())
+                        throw GraphFileError{ filename, chunk.error };
+
+                for (auto & chunk : chunks) {
+                    for (auto & edge : chunk.edges)
+                        add_edge(edge.first, edge.second);
+
+                    chunk.edges = decltype(chunk.edges)();
+                }
+            });
+    }
+}
+
+auto parasols::read_dimacs(InputFile & input, const GraphOptions & options) -> Graph
+{
+    Graph result(0, true);
+
+    read_dimacs_edges(input, options,
+            [&] (int size) { result.resize(size); },
+            [&] (int a, int b) { result.add_edge(a, b); });
 
     return result;
 }
 
+auto parasols::read_dimacs(const std::string & filename, const GraphOptions & options) -> Graph
+{
+    InputFile input{ filename };
+    return read_dimacs(input, options);
+}
+
+auto parasols::read_sparse_dimacs(const std::string & filename, const GraphOptions & options) -> SparseGraph
+{
+    return read_sparse_graph(filename, true, [&] (InputFile & input, const auto & set_size, const auto & add_edge) {
+            read_dimacs_edges(input, options, set_size, add_edge);
+            });
+}
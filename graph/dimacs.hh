@@ -4,6 +4,8 @@
 #define PARASOLS_GUARD_GRAPH_DIMACS_HH 1
 
 #include <graph/graph.hh>
+#include <graph/sparse_graph.hh>
+#include <graph/input_file.hh>
 #include <string>
 
 namespace parasols
@@ -14,6 +16,20 @@ namespace parasols
      * \throw GraphFileError
      */
     auto read_dimacs(const std::string & filename, const GraphOptions & options) -> Graph;
+
+    /**
+     * Read DIMACS format from an InputFile which has not yet been used.
+     *
+     * \throw GraphFileError
+     */
+    auto read_dimacs(InputFile & input, const GraphOptions & options) -> Graph;
+
+    /**
+     * Read a DIMACS format file into a SparseGraph.
+     *
+     * \throw GraphFileError
+     */
+    auto read_sparse_dimacs(const std::string & filename, const GraphOptions & options) -> SparseGraph;
 }
 
 #endif
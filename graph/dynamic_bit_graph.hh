@@ -0,0 +1,381 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_DYNAMIC_BIT_GRAPH_HH
+#define PARASOLS_GUARD_GRAPH_DYNAMIC_BIT_GRAPH_HH 1
+
+#include <graph/bit_graph.hh>
+
+#include <vector>
+#include <algorithm>
+
+namespace parasols
+{
+    /**
+     * How many words do we need to hold this many bits?
+     */
+    inline auto words_for_bits(int bits) -> int
+    {
+        return (bits + bits_per_word - 1) / bits_per_word;
+    }
+
+    /**
+     * A bitset whose size is decided at runtime. This provides the same
+     * operations as FixedBitSet, so algorithms can use exactly as many words
+     * as the graph needs, rather than rounding up to the next FixedBitSet
+     * size.
+     *
+     * Copying allocates, so algorithms should keep one of these per depth
+     * and assign into it, rather than making new ones as they go. Assigning
+     * between sets of the same size does not allocate.
+     *
+     * Indices start at 0.
+     */
+    class DynamicBitSet
+    {
+        private:
+            using Bits = std::vector<BitWord>;
+
+            Bits _bits;
+
+        public:
+            DynamicBitSet() = default;
+
+            /**
+             * \param n_words is the number of words, not bits.
+             */
+            explicit DynamicBitSet(int n_words) :
+                _bits(n_words, 0)
+            {
+            }
+
+            /**
+             * How many words do we have?
+             */
+            auto n_words() const -> int
+            {
+                return _bits.size();
+            }
+
+            /**
+             * Our words, for algorithms which want to work on them directly.
+             */
+            auto words() -> BitWord *
+            {
+                return _bits.data();
+            }
+
+            /**
+             * Our words, for algorithms which want to work on them directly.
+             */
+            auto words() const -> const BitWord *
+            {
+                return _bits.data();
+            }
+
+            /**
+             * Change how many words we have. Any new words are cleared.
+             */
+            auto resize_words(int n_words) -> void
+            {
+                _bits.resize(n_words, 0);
+            }
+
+            /**
+             * Set a given bit 'on'.
+             */
+            auto set(int a) -> void
+            {
+                _bits[a / bits_per_word] |= (BitWord{ 1 } << (a % bits_per_word));
+            }
+
+            /**
+             * Replace our contents with the given words. Any words past
+             * n_words are cleared.
+             */
+            auto set_words(const BitWord * words, int n_words) -> void
+            {
+                n_words = std::min<int>(n_words, _bits.size());
+                std::copy(words, words + n_words, _bits.begin());
+                std::fill(_bits.begin() + n_words, _bits.end(), 0);
+            }
+
+            /**
+             * Set a given bit 'off'.
+             */
+            auto unset(int a) -> void
+            {
+                _bits[a / bits_per_word] &= ~(BitWord{ 1 } << (a % bits_per_word));
+            }
+
+            /**
+             * Set bits [0, size) on, and everything else off.
+             */
+            auto set_up_to(int size) -> void
+            {
+                unset_all();
+                std::fill(_bits.begin(), _bits.begin() + size / bits_per_word, ~BitWord{ 0 });
+                if (0 != size % bits_per_word)
+                    _bits[size / bits_per_word] = (BitWord{ 1 } << (size % bits_per_word)) - 1;
+            }
+
+            /**
+             * Set all bits off.
+             */
+            auto unset_all() -> void
+            {
+                std::fill(_bits.begin(), _bits.end(), 0);
+            }
+
+            /**
+             * Is a given bit on?
+             */
+            auto test(int a) const -> bool
+            {
+                return _bits[a / bits_per_word] & (BitWord{ 1 } << (a % bits_per_word));
+            }
+
+            /**
+             * How many bits are on?
+             */
+            auto popcount() const -> unsigned
+            {
+                unsigned result = 0;
+                for (auto & p : _bits)
+                    result += __builtin_popcountll(p);
+                return result;
+            }
+
+            /**
+             * Are any bits on?
+             */
+            auto empty() const -> bool
+            {
+                for (auto & p : _bits)
+                    if (0 != p)
+                        return false;
+                return true;
+            }
+
+            /**
+             * Intersect (bitwise-and) with some words, which must be at
+             * least as long as we are.
+             */
+            auto intersect_with_words(const BitWord * words) -> void
+            {
+                for (Bits::size_type i = 0, i_end = _bits.size() ; i < i_end ; ++i)
+                    _bits[i] &= words[i];
+            }
+
+            /**
+             * Intersect with the complement of some words, which must be at
+             * least as long as we are.
+             */
+            auto intersect_with_complement_of_words(const BitWord * words) -> void
+            {
+                for (Bits::size_type i = 0, i_end = _bits.size() ; i < i_end ; ++i)
+                    _bits[i] &= ~words[i];
+            }
+
+            /**
+             * Become the intersection of another set of the same size and
+             * some words. This saves a pass over the words compared to
+             * copying and then intersecting.
+             */
+            auto assign_intersection(const DynamicBitSet & other, const BitWord * words) -> void
+            {
+                for (Bits::size_type i = 0, i_end = _bits.size() ; i < i_end ; ++i)
+                    _bits[i] = other._bits[i] & words[i];
+            }
+
+            /**
+             * Intersect (bitwise-and) with another set of the same size.
+             */
+            auto intersect_with(const DynamicBitSet & other) -> void
+            {
+                intersect_with_words(other._bits.data());
+            }
+
+            /**
+             * Union (bitwise-or) with another set of the same size.
+             */
+            auto union_with(const DynamicBitSet & other) -> void
+            {
+                for (Bits::size_type i = 0, i_end = _bits.size() ; i < i_end ; ++i)
+                    _bits[i] |= other._bits[i];
+            }
+
+            /**
+             * Intersect with the complement of another set of the same size.
+             */
+            auto intersect_with_complement(const DynamicBitSet & other) -> void
+            {
+                intersect_with_complement_of_words(other._bits.data());
+            }
+
+            /**
+             * Return the index of the first set ('on') bit, or -1 if we are
+             * empty.
+             */
+            auto first_set_bit() const -> int
+            {
+                for (Bits::size_type i = 0 ; i < _bits.size() ; ++i) {
+                    int b = __builtin_ffsll(_bits[i]);
+                    if (0 != b)
+                        return i * bits_per_word + b - 1;
+                }
+                return -1;
+            }
+
+            /**
+             * Return the index of the last set ('on') bit, or -1 if we are
+             * empty.
+             */
+            auto last_set_bit() const -> int
+            {
+                for (int i = _bits.size() - 1 ; i >= 0 ; --i) {
+                    if (0 == _bits[i])
+                        continue;
+
+                    int b = __builtin_clzll(_bits[i]);
+                    return (i + 1) * bits_per_word - b - 1;
+                }
+                return -1;
+            }
+
+            auto operator== (const DynamicBitSet & other) const -> bool
+            {
+                return _bits == other._bits;
+            }
+    };
+
+    /**
+     * A bit graph whose size is decided at runtime, with rows which are
+     * exactly as many words wide as are needed. The rows are stored one
+     * after another in a single block. This provides the same operations as
+     * FixedBitGraph, working on DynamicBitSet.
+     *
+     * Indices start at 0.
+     */
+    class DynamicBitGraph
+    {
+        private:
+            int _size = 0;
+            int _words_per_row = 0;
+            std::vector<BitWord> _adjacency;
+
+            auto _row(int a) const -> const BitWord *
+            {
+                return &_adjacency[std::size_t(a) * _words_per_row];
+            }
+
+            auto _row(int a) -> BitWord *
+            {
+                return &_adjacency[std::size_t(a) * _words_per_row];
+            }
+
+        public:
+            /**
+             * Return the actual size.
+             */
+            auto size() const -> int
+            {
+                return _size;
+            }
+
+            /**
+             * How many words are there in each row? DynamicBitSets used with
+             * this graph should be this big.
+             */
+            auto words_per_row() const -> int
+            {
+                return _words_per_row;
+            }
+
+            /**
+             * Change our size. Any existing edges are lost.
+             */
+            auto resize(int size) -> void
+            {
+                check_bit_graph_memory_budget(size, words_for_bits(size));
+                _size = size;
+                _words_per_row = words_for_bits(size);
+                _adjacency.assign(std::size_t(size) * _words_per_row, 0);
+            }
+
+            /**
+             * Add an edge from a to b (and from b to a).
+             */
+            auto add_edge(int a, int b) -> void
+            {
+                _row(a)[b / bits_per_word] |= (BitWord{ 1 } << (b % bits_per_word));
+                _row(b)[a / bits_per_word] |= (BitWord{ 1 } << (a % bits_per_word));
+            }
+
+            /**
+             * Replace the row for a given vertex with the given words. The
+             * caller must keep the graph symmetric.
+             */
+            auto set_neighbourhood_words(int a, const BitWord * words, int n_words) -> void
+            {
+                n_words = std::min(n_words, _words_per_row);
+                std::copy(words, words + n_words, _row(a));
+                std::fill(_row(a) + n_words, _row(a) + _words_per_row, 0);
+            }
+
+            /**
+             * Are vertices a and b adjacent?
+             */
+            auto adjacent(int a, int b) const -> bool
+            {
+                return _row(a)[b / bits_per_word] & (BitWord{ 1 } << (b % bits_per_word));
+            }
+
+            /**
+             * What is the degree of a given vertex?
+             */
+            auto degree(int a) const -> int
+            {
+                int result = 0;
+                for (const BitWord * w = _row(a), * w_end = _row(a) + _words_per_row ; w != w_end ; ++w)
+                    result += __builtin_popcountll(*w);
+                return result;
+            }
+
+            /**
+             * The words making up the row for a particular vertex.
+             */
+            auto neighbourhood_words(int a) const -> const BitWord *
+            {
+                return _row(a);
+            }
+
+            /**
+             * Intersect the supplied bitset with a particular row.
+             */
+            auto intersect_with_row(int row, DynamicBitSet & p) const -> void
+            {
+                p.intersect_with_words(_row(row));
+            }
+
+            /**
+             * Intersect the supplied bitset with the complement of a
+             * particular row.
+             */
+            auto intersect_with_row_complement(int row, DynamicBitSet & p) const -> void
+            {
+                p.intersect_with_complement_of_words(_row(row));
+            }
+
+            /**
+             * Fetch the neighbourhood of a particular vertex.
+             */
+            auto neighbourhood(int vertex) const -> DynamicBitSet
+            {
+                DynamicBitSet result(_words_per_row);
+                result.set_words(_row(vertex), _words_per_row);
+                return result;
+            }
+    };
+}
+
+#endif
@@ -10,6 +10,8 @@
 #include <graph/mivia.hh>
 #include <graph/adj.hh>
 #include <graph/lad.hh>
+#include <graph/binary.hh>
+#include <graph/detect_format.hh>
 
 #include <utility>
 #include <functional>
@@ -20,21 +22,38 @@ namespace parasols
     {
         using GraphFileFormatFunction = std::function<Graph (const std::string &, const GraphOptions &)>;
 
+        /* Some readers can also take an InputFile, so we have to say which
+         * one we mean. */
+        using ReadGraphFunction = auto (*) (const std::string &, const GraphOptions &) -> Graph;
+
         using namespace std::placeholders;
 
         auto graph_file_formats = {
-            std::make_pair( std::string{ "dimacs" },  GraphFileFormatFunction{ std::bind(read_dimacs, _1, _2) } ),
+            std::make_pair( std::string{ "dimacs" },  GraphFileFormatFunction{ std::bind(ReadGraphFunction{ read_dimacs }, _1, _2) } ),
             std::make_pair( std::string{ "pairs0" },  GraphFileFormatFunction{ std::bind(read_pairs, _1, false, _2) } ),
             std::make_pair( std::string{ "pairs1" },  GraphFileFormatFunction{ std::bind(read_pairs, _1, true, _2) } ),
-            std::make_pair( std::string{ "net" },     GraphFileFormatFunction{ std::bind(read_net, _1, _2) } ),
-            std::make_pair( std::string{ "metis" },   GraphFileFormatFunction{ std::bind(read_metis, _1, _2) } ),
-            std::make_pair( std::string{ "mivia" },   GraphFileFormatFunction{ std::bind(read_mivia, _1, _2) } ),
-            std::make_pair( std::string{ "adj" },     GraphFileFormatFunction{ std::bind(read_adj, _1, _2) } ),
-            std::make_pair( std::string{ "lad" },     GraphFileFormatFunction{ std::bind(read_lad, _1, _2) } )
+            std::make_pair( std::string{ "net" },     GraphFileFormatFunction{ std::bind(ReadGraphFunction{ read_net }, _1, _2) } ),
+            std::make_pair( std::string{ "metis" },   GraphFileFormatFunction{ std::bind(ReadGraphFunction{ read_metis }, _1, _2) } ),
+            std::make_pair( std::string{ "mivia" },   GraphFileFormatFunction{ std::bind(ReadGraphFunction{ read_mivia }, _1, _2) } ),
+            std::make_pair( std::string{ "adj" },     GraphFileFormatFunction{ std::bind(ReadGraphFunction{ read_adj }, _1, _2) } ),
+            std::make_pair( std::string{ "lad" },     GraphFileFormatFunction{ std::bind(ReadGraphFunction{ read_lad }, _1, _2) } ),
+            std::make_pair( std::string{ "binary" },  GraphFileFormatFunction{ std::bind(ReadGraphFunction{ read_binary }, _1, _2) } ),
+            std::make_pair( std::string{ "auto" },    GraphFileFormatFunction{ std::bind(read_auto, _1, _2) } )
+        };
+
+        using SparseGraphFileFormatFunction = std::function<SparseGraph (const std::string &, const GraphOptions &)>;
+
+        auto sparse_graph_file_formats = {
+            std::make_pair( std::string{ "dimacs" },  SparseGraphFileFormatFunction{ std::bind(read_sparse_dimacs, _1, _2) } ),
+            std::make_pair( std::string{ "pairs0" },  SparseGraphFileFormatFunction{ std::bind(read_sparse_pairs, _1, false, _2) } ),
+            std::make_pair( std::string{ "pairs1" },  SparseGraphFileFormatFunction{ std::bind(read_sparse_pairs, _1, true, _2) } ),
+            std::make_pair( std::string{ "metis" },   SparseGraphFileFormatFunction{ std::bind(read_sparse_metis, _1, _2) } ),
+            std::make_pair( std::string{ "lad" },     SparseGraphFileFormatFunction{ std::bind(read_sparse_lad, _1, _2) } )
         };
     }
 
     using detail::graph_file_formats;
+    using detail::sparse_graph_file_formats;
 }
 
 #endif
@@ -0,0 +1,55 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/fingerprint.hh>
+#include <graph/permute_graph.hh>
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+
+using namespace parasols;
+
+namespace
+{
+    auto mix(std::uint64_t z) -> std::uint64_t
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+}
+
+auto parasols::fingerprint(const Graph & graph) -> std::string
+{
+    std::mutex mutex;
+    std::uint64_t sum[2] = { 0, 0 };
+
+    for_each_row_range(graph.size(), [&] (int begin, int end) {
+            std::uint64_t partial[2] = { 0, 0 };
+
+            for (int v = begin ; v < end ; ++v) {
+                /* Two independent lanes, each starting from the row number. */
+                std::uint64_t h[2] = { mix(2 * std::uint64_t(v) + 1), mix(2 * std::uint64_t(v) + 2) };
+
+                const BitWord * row = graph.neighbourhood_words(v);
+                for (int w = 0 ; w < graph.words_per_row() ; ++w) {
+                    h[0] = mix(h[0] ^ row[w]) + 0x9e3779b97f4a7c15ull;
+                    h[1] = mix(h[1] + row[w]) ^ 0xd1b54a32d192ed03ull;
+                }
+
+                partial[0] += h[0];
+                partial[1] += h[1];
+            }
+
+            std::unique_lock<std::mutex> guard(mutex);
+            sum[0] += partial[0];
+            sum[1] += partial[1];
+            });
+
+    std::uint64_t size = graph.size();
+    char result[33];
+    std::snprintf(result, sizeof(result), "%016llx%016llx",
+            static_cast<unsigned long long>(mix(sum[0] ^ mix(size))),
+            static_cast<unsigned long long>(mix(sum[1] + mix(~size))));
+    return result;
+}
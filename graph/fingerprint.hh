@@ -0,0 +1,24 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_FINGERPRINT_HH
+#define PARASOLS_GUARD_GRAPH_FINGERPRINT_HH 1
+
+#include <graph/graph.hh>
+
+#include <string>
+
+namespace parasols
+{
+    /**
+     * A 128 bit hash of a graph's size and adjacency matrix, as 32 hex
+     * digits. Two graphs with the same fingerprint are, to all intents and
+     * purposes, the same graph with the same vertex numbering. Vertex names
+     * are not included.
+     *
+     * Each row is hashed separately, in parallel, and the row hashes are
+     * summed, so this takes about as long as reading the bit rows once.
+     */
+    auto fingerprint(const Graph & graph) -> std::string;
+}
+
+#endif
@@ -14,24 +14,34 @@ Graph::Graph(int size, bool add_one_for_output) :
 
 auto Graph::_position(int a, int b) const -> AdjacencyMatrix::size_type
 {
-    return (a * _size) + b;
+    return AdjacencyMatrix::size_type(a) * _words_per_row + (b / bits_per_word);
 }
 
 auto Graph::resize(int size) -> void
 {
     _size = size;
-    _adjacency.resize(size * size);
+    _words_per_row = (size + bits_per_word - 1) / bits_per_word;
+    _adjacency.resize(AdjacencyMatrix::size_type(size) * _words_per_row);
+    _degrees.resize(size);
 }
 
 auto Graph::add_edge(int a, int b) -> void
 {
-    _adjacency[_position(a, b)] = 1;
-    _adjacency[_position(b, a)] = 1;
+    if (adjacent(a, b))
+        return;
+
+    _adjacency[_position(a, b)] |= (BitWord{ 1 } << (b % bits_per_word));
+    ++_degrees[a];
+
+    if (a != b) {
+        _adjacency[_position(b, a)] |= (BitWord{ 1 } << (a % bits_per_word));
+        ++_degrees[b];
+    }
 }
 
 auto Graph::adjacent(int a, int b) const -> bool
 {
-    return _adjacency[_position(a, b)];
+    return _adjacency[_position(a, b)] & (BitWord{ 1 } << (b % bits_per_word));
 }
 
 auto Graph::size() const -> int
@@ -41,14 +51,39 @@ auto Graph::size() const -> int
 
 auto Graph::degree(int a) const -> int
 {
-    return std::count_if(
-            _adjacency.begin() + a * _size,
-            _adjacency.begin() + (a + 1) * _size,
-            [] (int x) { return !!x; });
+    return _degrees[a];
+}
+
+auto Graph::words_per_row() const -> int
+{
+    return _words_per_row;
+}
+
+auto Graph::neighbourhood_words(int a) const -> const BitWord *
+{
+    return &_adjacency[AdjacencyMatrix::size_type(a) * _words_per_row];
+}
+
+auto Graph::set_neighbourhood_words(int a, const BitWord * words) -> void
+{
+    auto row = _adjacency.begin() + AdjacencyMatrix::size_type(a) * _words_per_row;
+    std::copy(words, words + _words_per_row, row);
+
+    _degrees[a] = 0;
+    for (int w = 0 ; w < _words_per_row ; ++w)
+        _degrees[a] += __builtin_popcountll(words[w]);
+}
+
+auto Graph::set_vertex_labels(const std::vector<int> & labels) -> void
+{
+    _vertex_labels = labels;
 }
 
 auto Graph::vertex_name(int a) const -> std::string
 {
+    if (! _vertex_labels.empty())
+        a = _vertex_labels[a];
+
     if (_add_one_for_output)
         return std::to_string(a + 1);
     else
@@ -57,9 +92,12 @@ auto Graph::vertex_name(int a) const -> std::string
 
 auto Graph::vertex_number(const std::string & t) const -> int
 {
+    int a = std::stoi(t);
     if (_add_one_for_output)
-        return std::stoi(t) - 1;
-    else
-        return std::stoi(t);
-}
+        --a;
 
+    if (! _vertex_labels.empty())
+        a = std::find(_vertex_labels.begin(), _vertex_labels.end(), a) - _vertex_labels.begin();
+
+    return a;
+}
@@ -3,10 +3,11 @@
 #ifndef PARASOLS_GUARD_GRAPH_GRAPH_HH
 #define PARASOLS_GUARD_GRAPH_GRAPH_HH 1
 
+#include <graph/bit_graph.hh>
+
 #include <vector>
 #include <string>
 #include <type_traits>
-#include <cstdint>
 
 namespace parasols
 {
@@ -14,6 +15,10 @@ namespace parasols
      * A graph, with an adjaceny matrix representation. We only provide the
      * operations we actually need.
      *
+     * The adjacency matrix is bit-packed, one row of words per vertex, and
+     * we keep degrees up to date as edges are added, so degree() is
+     * constant time.
+     *
      * Indices start at 0.
      */
     class Graph
@@ -23,16 +28,19 @@ namespace parasols
              * The adjaceny matrix type. Shouldn't really be public, but we
              * snoop around inside it when doing message passing.
              */
-            using AdjacencyMatrix = std::vector<std::uint8_t>;
+            using AdjacencyMatrix = std::vector<BitWord>;
 
         private:
             int _size = 0;
+            int _words_per_row = 0;
             AdjacencyMatrix _adjacency;
+            std::vector<int> _degrees;
+            std::vector<int> _vertex_labels;
             bool _add_one_for_output;
 
             /**
-             * Return the appropriate offset into _adjacency for the edge (a,
-             * b).
+             * Return the appropriate offset into _adjacency for the word
+             * holding the edge (a, b).
              */
             auto _position(int a, int b) const -> AdjacencyMatrix::size_type;
 
@@ -47,6 +55,10 @@ namespace parasols
             Graph(int initial_size, bool add_one_for_output);
 
             Graph(const Graph &) = default;
+            Graph(Graph &&) = default;
+
+            Graph & operator= (const Graph &) = default;
+            Graph & operator= (Graph &&) = default;
 
             explicit Graph() = default;
 
@@ -72,10 +84,44 @@ namespace parasols
             auto adjacent(int a, int b) const -> bool;
 
             /**
-             * What is the degree of a given vertex?
+             * What is the degree of a given vertex? A loop counts once.
              */
             auto degree(int a) const -> int;
 
+            /**
+             * How many words make up each row of the adjacency matrix?
+             */
+            auto words_per_row() const -> int;
+
+            /**
+             * The words making up the row of the adjacency matrix for a given
+             * vertex. Bits past size() are always zero.
+             */
+            auto neighbourhood_words(int a) const -> const BitWord *;
+
+            /**
+             * Replace the row of the adjacency matrix for a given vertex,
+             * which has words_per_row() words. The caller must keep the
+             * matrix symmetric, and must not set bits past size().
+             */
+            auto set_neighbourhood_words(int a, const BitWord * words) -> void;
+
+            /**
+             * Give our vertices different numbers for output: vertex a will
+             * be displayed as labels[a] (plus one, if add_one_for_output).
+             * This is used when a graph is stored with its vertices
+             * permuted.
+             */
+            auto set_vertex_labels(const std::vector<int> & labels) -> void;
+
+            /**
+             * Our vertex labels, or empty if we don't have any.
+             */
+            auto vertex_labels() const -> const std::vector<int> &
+            {
+                return _vertex_labels;
+            }
+
             /**
              * Format a vertex for outputting.
              *
@@ -98,7 +144,7 @@ namespace parasols
              * The adjaceny matrix. Shouldn't really be public, but we snoop
              * around inside it when doing message passing.
              */
-            auto adjaceny_matrix() -> AdjacencyMatrix &
+            auto adjaceny_matrix() const -> const AdjacencyMatrix &
             {
                 return _adjacency;
             }
@@ -14,3 +14,12 @@ auto GraphFileError::what() const throw () -> const char *
     return _what.c_str();
 }
 
+GraphFileWriteError::GraphFileWriteError(const std::string & filename, const std::string & message) throw () :
+    _what("Error writing graph file '" + filename + "': " + message)
+{
+}
+
+auto GraphFileWriteError::what() const throw () -> const char *
+{
+    return _what.c_str();
+}
@@ -23,6 +23,21 @@ namespace parasols
 
             auto what() const throw () -> const char *;
     };
+
+    /**
+     * Thrown if we can't write a graph file.
+     */
+    class GraphFileWriteError :
+        public std::exception
+    {
+        private:
+            std::string _what;
+
+        public:
+            GraphFileWriteError(const std::string & filename, const std::string & message) throw ();
+
+            auto what() const throw () -> const char *;
+    };
 }
 
 #endif
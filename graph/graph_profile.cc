@@ -0,0 +1,350 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/graph_profile.hh>
+#include <graph/degree_elimination.hh>
+#include <graph/permute_graph.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+using namespace parasols;
+
+namespace
+{
+    auto has_loop(const Graph & graph, int v) -> bool
+    {
+        return graph.adjacent(v, v);
+    }
+
+    template <typename F_>
+    auto for_each_bit(const BitWord * words, int n_words, const F_ & f) -> void
+    {
+        for (int w = 0 ; w < n_words ; ++w) {
+            BitWord bits = words[w];
+            while (0 != bits) {
+                int b = __builtin_ctzll(bits);
+                bits &= bits - 1;
+                f(w * bits_per_word + b);
+            }
+        }
+    }
+
+    /**
+     * Core numbers, and the smallest-last order, by repeatedly removing a
+     * vertex of minimum degree.
+     */
+    auto cores(const Graph & graph, const std::vector<int> & degrees, GraphProfile & profile) -> std::vector<int>
+    {
+        int max_degree = 0;
+        for (auto & d : degrees)
+            max_degree = std::max(max_degree, d);
+
+        DegreeBuckets buckets(graph.size(), max_degree);
+        std::vector<int> current = degrees;
+        for (int v = 0 ; v < graph.size() ; ++v)
+            buckets.insert(v, current[v]);
+
+        std::vector<BitWord> remaining(graph.words_per_row(), 0);
+        for (int v = 0 ; v < graph.size() ; ++v)
+            remaining[v / bits_per_word] |= (BitWord{ 1 } << (v % bits_per_word));
+
+        std::vector<int> order;
+        order.reserve(graph.size());
+        profile.core_numbers.assign(graph.size(), 0);
+
+        int k = 0;
+        for (int i = 0 ; i < graph.size() ; ++i) {
+            int v = -1;
+            buckets.for_each(buckets.lowest(), [&] (int u) { v = u; });
+
+            k = std::max(k, current[v]);
+            profile.core_numbers[v] = k;
+            order.push_back(v);
+
+            buckets.erase(v, current[v]);
+            remaining[v / bits_per_word] &= ~(BitWord{ 1 } << (v % bits_per_word));
+
+            const BitWord * row = graph.neighbourhood_words(v);
+            for (int w = 0 ; w < graph.words_per_row() ; ++w) {
+                BitWord bits = row[w] & remaining[w];
+                while (0 != bits) {
+                    int u = w * bits_per_word + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    buckets.erase(u, current[u]);
+                    buckets.insert(u, --current[u]);
+                }
+            }
+        }
+
+        profile.degeneracy = k;
+        profile.max_core_size = std::count(profile.core_numbers.begin(), profile.core_numbers.end(), k);
+
+        return order;
+    }
+
+    /**
+     * Triangles through each vertex. For each edge, the number of triangles
+     * it is in is the popcount of its endpoints' rows anded together.
+     */
+    auto triangles(const Graph & graph, const std::vector<int> & degrees, GraphProfile & profile) -> void
+    {
+        std::vector<unsigned long long> through(graph.size(), 0);
+        std::mutex through_mutex;
+
+        for_each_row_range(graph.size(), [&] (int begin, int end) {
+                std::vector<unsigned long long> local(graph.size(), 0);
+
+                for (int i = begin ; i < end ; ++i) {
+                    const BitWord * row_i = graph.neighbourhood_words(i);
+
+                    for (int w = i / bits_per_word ; w < graph.words_per_row() ; ++w) {
+                        BitWord bits = row_i[w];
+                        if (w == i / bits_per_word)
+                            bits &= ~((BitWord{ 2 } << (i % bits_per_word)) - 1);
+
+                        while (0 != bits) {
+                            int j = w * bits_per_word + __builtin_ctzll(bits);
+                            bits &= bits - 1;
+
+                            const BitWord * row_j = graph.neighbourhood_words(j);
+                            long long common = 0;
+                            for (int x = 0 ; x < graph.words_per_row() ; ++x)
+                                common += __builtin_popcountll(row_i[x] & row_j[x]);
+
+                            // i and j are in both rows if they have loops
+                            common -= has_loop(graph, i) + has_loop(graph, j);
+                            local[i] += common;
+                            local[j] += common;
+                        }
+                    }
+                }
+
+                std::unique_lock<std::mutex> guard(through_mutex);
+                for (int i = 0 ; i < graph.size() ; ++i)
+                    through[i] += local[i];
+            });
+
+        // each triangle through i was seen from both of its other vertices
+        for (auto & t : through)
+            t /= 2;
+
+        unsigned long long total = 0, paths = 0;
+        double local = 0.0;
+        for (int i = 0 ; i < graph.size() ; ++i) {
+            total += through[i];
+            unsigned long long pairs = (unsigned long long)(degrees[i]) * (degrees[i] - 1) / 2;
+            paths += pairs;
+            if (pairs > 0)
+                local += double(through[i]) / pairs;
+        }
+
+        profile.triangles = total / 3;
+        profile.global_clustering = paths > 0 ? double(total) / paths : 0.0;
+        profile.mean_local_clustering = graph.size() > 0 ? local / graph.size() : 0.0;
+    }
+
+    /**
+     * Greedy sequential colouring, colouring in reverse of the given
+     * smallest-last order.
+     */
+    auto greedy_colouring(const Graph & graph, const std::vector<int> & order, GraphProfile & profile) -> void
+    {
+        std::vector<int> colour(graph.size(), -1);
+        std::vector<int> used_by(graph.size() + 1, -1);
+        int n_colours = 0;
+
+        for (auto v = order.rbegin() ; v != order.rend() ; ++v) {
+            for_each_bit(graph.neighbourhood_words(*v), graph.words_per_row(), [&] (int u) {
+                    if (-1 != colour[u])
+                        used_by[colour[u]] = *v;
+                    });
+
+            int c = 0;
+            while (used_by[c] == *v)
+                ++c;
+
+            colour[*v] = c;
+            n_colours = std::max(n_colours, c + 1);
+        }
+
+        profile.greedy_colours = n_colours;
+    }
+
+    /**
+     * Grow a clique greedily from every vertex whose core number leaves room
+     * for it to beat what we have, always adding the candidate with the
+     * highest core number.
+     */
+    auto greedy_clique(const Graph & graph, GraphProfile & profile) -> void
+    {
+        std::atomic<int> best{ graph.size() > 0 ? 1 : 0 };
+        const auto & core = profile.core_numbers;
+
+        for_each_row_range(graph.size(), [&] (int begin, int end) {
+                std::vector<BitWord> p(graph.words_per_row());
+
+                for (int v = begin ; v < end ; ++v) {
+                    if (core[v] + 1 <= best)
+                        continue;
+
+                    const BitWord * row = graph.neighbourhood_words(v);
+                    std::copy(row, row + graph.words_per_row(), p.begin());
+                    p[v / bits_per_word] &= ~(BitWord{ 1 } << (v % bits_per_word));
+
+                    int size = 1;
+                    while (true) {
+                        int next = -1, left = 0;
+                        for_each_bit(p.data(), graph.words_per_row(), [&] (int u) {
+                                ++left;
+                                if (-1 == next || core[u] > core[next])
+                                    next = u;
+                                });
+
+                        if (-1 == next || size + left <= best)
+                            break;
+
+                        ++size;
+                        const BitWord * next_row = graph.neighbourhood_words(next);
+                        for (int w = 0 ; w < graph.words_per_row() ; ++w)
+                            p[w] &= next_row[w];
+                        p[next / bits_per_word] &= ~(BitWord{ 1 } << (next % bits_per_word));
+                    }
+
+                    int old = best;
+                    while (size > old && ! best.compare_exchange_weak(old, size))
+                        ;
+                }
+            });
+
+        profile.greedy_clique = best;
+    }
+
+    /**
+     * Connected components, by breadth first search with bitset frontiers.
+     */
+    auto components(const Graph & graph, GraphProfile & profile) -> void
+    {
+        std::vector<BitWord> unvisited(graph.words_per_row(), 0), frontier(graph.words_per_row()),
+            next(graph.words_per_row());
+        for (int v = 0 ; v < graph.size() ; ++v)
+            unvisited[v / bits_per_word] |= (BitWord{ 1 } << (v % bits_per_word));
+
+        for (int w = 0 ; w < graph.words_per_row() ; ++w) {
+            while (0 != unvisited[w]) {
+                int v = w * bits_per_word + __builtin_ctzll(unvisited[w]);
+                std::fill(frontier.begin(), frontier.end(), 0);
+                frontier[v / bits_per_word] |= (BitWord{ 1 } << (v % bits_per_word));
+                unvisited[v / bits_per_word] &= ~(BitWord{ 1 } << (v % bits_per_word));
+
+                int size = 1;
+                while (true) {
+                    std::fill(next.begin(), next.end(), 0);
+                    for_each_bit(frontier.data(), graph.words_per_row(), [&] (int u) {
+                            const BitWord * row = graph.neighbourhood_words(u);
+                            for (int x = 0 ; x < graph.words_per_row() ; ++x)
+                                next[x] |= row[x];
+                            });
+
+                    BitWord any = 0;
+                    for (int x = 0 ; x < graph.words_per_row() ; ++x) {
+                        next[x] &= unvisited[x];
+                        unvisited[x] &= ~next[x];
+                        size += __builtin_popcountll(next[x]);
+                        any |= next[x];
+                    }
+
+                    if (0 == any)
+                        break;
+
+                    std::swap(frontier, next);
+                }
+
+                ++profile.components;
+                profile.largest_component = std::max(profile.largest_component, size);
+            }
+        }
+    }
+}
+
+auto parasols::profile_graph(const Graph & graph) -> GraphProfile
+{
+    GraphProfile profile;
+    profile.vertices = graph.size();
+
+    std::vector<int> degrees(graph.size());
+    unsigned long long degree_sum = 0;
+    for (int v = 0 ; v < graph.size() ; ++v) {
+        if (has_loop(graph, v))
+            ++profile.loops;
+
+        degrees[v] = graph.degree(v) - has_loop(graph, v);
+        degree_sum += degrees[v];
+    }
+
+    profile.edges = degree_sum / 2;
+    if (graph.size() > 0) {
+        profile.min_degree = *std::min_element(degrees.begin(), degrees.end());
+        profile.max_degree = *std::max_element(degrees.begin(), degrees.end());
+        profile.mean_degree = double(degree_sum) / graph.size();
+    }
+    if (graph.size() > 1)
+        profile.density = 2.0 * profile.edges / (double(graph.size()) * (graph.size() - 1));
+
+    auto order = cores(graph, degrees, profile);
+    triangles(graph, degrees, profile);
+    greedy_colouring(graph, order, profile);
+    greedy_clique(graph, profile);
+    components(graph, profile);
+
+    return profile;
+}
+
+auto parasols::write_profile_text(std::ostream & s, const GraphProfile & profile) -> void
+{
+    s << "vertices " << profile.vertices << std::endl;
+    s << "edges " << profile.edges << std::endl;
+    s << "loops " << profile.loops << std::endl;
+    s << "min_degree " << profile.min_degree << std::endl;
+    s << "max_degree " << profile.max_degree << std::endl;
+    s << "mean_degree " << profile.mean_degree << std::endl;
+    s << "density " << profile.density << std::endl;
+    s << "degeneracy " << profile.degeneracy << std::endl;
+    s << "max_core_size " << profile.max_core_size << std::endl;
+    s << "triangles " << profile.triangles << std::endl;
+    s << "global_clustering " << profile.global_clustering << std::endl;
+    s << "mean_local_clustering " << profile.mean_local_clustering << std::endl;
+    s << "greedy_colours " << profile.greedy_colours << std::endl;
+    s << "greedy_clique " << profile.greedy_clique << std::endl;
+    s << "components " << profile.components << std::endl;
+    s << "largest_component " << profile.largest_component << std::endl;
+}
+
+auto parasols::write_profile_json(std::ostream & s, const std::string & filename, const GraphProfile & profile) -> void
+{
+    std::string escaped;
+    for (auto & c : filename) {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+
+    s << "{\"file\": \"" << escaped << "\""
+        << ", \"vertices\": " << profile.vertices
+        << ", \"edges\": " << profile.edges
+        << ", \"loops\": " << profile.loops
+        << ", \"min_degree\": " << profile.min_degree
+        << ", \"max_degree\": " << profile.max_degree
+        << ", \"mean_degree\": " << profile.mean_degree
+        << ", \"density\": " << profile.density
+        << ", \"degeneracy\": " << profile.degeneracy
+        << ", \"max_core_size\": " << profile.max_core_size
+        << ", \"triangles\": " << profile.triangles
+        << ", \"global_clustering\": " << profile.global_clustering
+        << ", \"mean_local_clustering\": " << profile.mean_local_clustering
+        << ", \"greedy_colours\": " << profile.greedy_colours
+        << ", \"greedy_clique\": " << profile.greedy_clique
+        << ", \"components\": " << profile.components
+        << ", \"largest_component\": " << profile.largest_component
+        << "}" << std::endl;
+}
@@ -0,0 +1,74 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_GRAPH_PROFILE_HH
+#define PARASOLS_GUARD_GRAPH_GRAPH_PROFILE_HH 1
+
+#include <graph/graph.hh>
+
+#include <vector>
+#include <ostream>
+#include <string>
+
+namespace parasols
+{
+    /**
+     * Structural statistics about a graph, for choosing algorithms and
+     * orders. Loops are counted, but otherwise ignored: degrees, cores,
+     * triangles and so on are all for the graph with its loops removed.
+     */
+    struct GraphProfile
+    {
+        int vertices = 0;
+        unsigned long long edges = 0;
+        unsigned long long loops = 0;
+
+        int min_degree = 0;
+        int max_degree = 0;
+        double mean_degree = 0.0;
+        double density = 0.0;
+
+        /// The largest k for which the graph has a non-empty k-core.
+        int degeneracy = 0;
+
+        /// The number of vertices in the degeneracy-core.
+        int max_core_size = 0;
+
+        /// The core number of each vertex.
+        std::vector<int> core_numbers;
+
+        unsigned long long triangles = 0;
+
+        /// Three times the number of triangles, over the number of paths of length two.
+        double global_clustering = 0.0;
+
+        /// The mean over all vertices of the local clustering coefficient.
+        double mean_local_clustering = 0.0;
+
+        /// Colours used by a greedy colouring in smallest-last order: an upper bound on the clique number.
+        int greedy_colours = 0;
+
+        /// Size of the biggest clique found greedily: a lower bound on the clique number.
+        int greedy_clique = 0;
+
+        int components = 0;
+        int largest_component = 0;
+    };
+
+    /**
+     * Work out a GraphProfile. The expensive parts are done on whole words of
+     * the adjacency matrix at a time, shared out between threads.
+     */
+    auto profile_graph(const Graph & graph) -> GraphProfile;
+
+    /**
+     * Write a profile as "name value" lines.
+     */
+    auto write_profile_text(std::ostream &, const GraphProfile &) -> void;
+
+    /**
+     * Write a profile as a single JSON object, without per-vertex data.
+     */
+    auto write_profile_json(std::ostream &, const std::string & filename, const GraphProfile &) -> void;
+}
+
+#endif
@@ -0,0 +1,181 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/graph_writer.hh>
+#include <graph/binary.hh>
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace parasols;
+
+namespace
+{
+    /* Shards are big enough to be worth giving to a thread, and small enough
+     * that we don't hold much of the output in memory at once. */
+    const constexpr unsigned long long shard_bytes = 1ull << 22;
+
+    auto append_number(std::string & buffer, unsigned n) -> void
+    {
+        char digits[16];
+        int n_digits = 0;
+        do {
+            digits[n_digits++] = '0' + n % 10;
+            n /= 10;
+        } while (0 != n);
+
+        while (n_digits > 0)
+            buffer.push_back(digits[--n_digits]);
+    }
+
+    auto number_length(unsigned n) -> unsigned
+    {
+        unsigned result = 1;
+        while (n >= 10) {
+            n /= 10;
+            ++result;
+        }
+        return result;
+    }
+
+    /**
+     * Call f(w) for each neighbour w of v, in order, skipping v itself, and
+     * also skipping everything before v if upper_only is set.
+     */
+    template <typename F_>
+    auto for_each_neighbour(const Graph & graph, int v, bool upper_only, const F_ & f) -> void
+    {
+        const BitWord * row = graph.neighbourhood_words(v);
+        int first_word = upper_only ? v / bits_per_word : 0;
+
+        for (int w = first_word ; w < graph.words_per_row() ; ++w) {
+            BitWord bits = row[w];
+            if (w == v / bits_per_word) {
+                BitWord self = BitWord{ 1 } << (v % bits_per_word);
+                bits &= upper_only ? ~((self << 1) - 1) : ~self;
+            }
+
+            while (0 != bits) {
+                int b = __builtin_ctzll(bits);
+                bits &= bits - 1;
+                f(w * bits_per_word + b);
+            }
+        }
+    }
+
+    /**
+     * Format every row using format_row(v, buffer), and write the results
+     * in order. Rows are grouped into shards of roughly shard_bytes, going
+     * by an estimate of bytes_per_neighbour for each neighbour, and up to
+     * n_threads shards are formatted at once.
+     */
+    template <typename F_>
+    auto write_rows(std::ostream & stream, const Graph & graph, unsigned n_threads, unsigned bytes_per_neighbour,
+            const F_ & format_row) -> void
+    {
+        std::vector<int> boundaries{ 0 };
+        unsigned long long estimate = 0;
+        for (int v = 0 ; v < graph.size() ; ++v) {
+            estimate += bytes_per_neighbour * (graph.degree(v) + 1ull);
+            if (estimate >= shard_bytes) {
+                boundaries.push_back(v + 1);
+                estimate = 0;
+            }
+        }
+        if (boundaries.back() != graph.size())
+            boundaries.push_back(graph.size());
+
+        unsigned n_shards = boundaries.size() - 1;
+        if (0 == n_threads)
+            n_threads = std::max(1u, std::thread::hardware_concurrency());
+        n_threads = std::max(1u, std::min(n_threads, n_shards));
+
+        std::vector<std::string> buffers(n_threads);
+
+        auto format_shard = [&] (unsigned shard, std::string & buffer) {
+            buffer.clear();
+            for (int v = boundaries[shard] ; v < boundaries[shard + 1] ; ++v)
+                format_row(v, buffer);
+        };
+
+        for (unsigned first = 0 ; first < n_shards ; first += n_threads) {
+            unsigned last = std::min(n_shards, first + n_threads);
+
+            if (1 == last - first)
+                format_shard(first, buffers[0]);
+            else {
+                std::vector<std::thread> threads;
+                for (unsigned shard = first ; shard < last ; ++shard)
+                    threads.emplace_back([&, shard] { format_shard(shard, buffers[shard - first]); });
+
+                for (auto & t : threads)
+                    t.join();
+            }
+
+            for (unsigned shard = first ; shard < last ; ++shard)
+                stream.write(buffers[shard - first].data(), buffers[shard - first].size());
+        }
+    }
+}
+
+auto parasols::write_dimacs(std::ostream & stream, const Graph & graph, unsigned n_threads) -> void
+{
+    stream << "p edge " << graph.size() << " 0\n";
+
+    unsigned length = number_length(graph.size());
+    write_rows(stream, graph, n_threads, 2 * length + 4, [&] (int v, std::string & buffer) {
+            std::string prefix = "e ";
+            append_number(prefix, v + 1);
+            prefix.push_back(' ');
+
+            for_each_neighbour(graph, v, true, [&] (int w) {
+                    buffer.append(prefix);
+                    append_number(buffer, w + 1);
+                    buffer.push_back('\n');
+                    });
+            });
+}
+
+auto parasols::write_pairs(std::ostream & stream, const Graph & graph, bool one_indexed, unsigned n_threads) -> void
+{
+    stream << graph.size() << " 0\n";
+
+    unsigned offset = one_indexed ? 1 : 0;
+    unsigned length = number_length(graph.size());
+    write_rows(stream, graph, n_threads, 2 * length + 2, [&] (int v, std::string & buffer) {
+            std::string prefix;
+            append_number(prefix, v + offset);
+            prefix.push_back(' ');
+
+            for_each_neighbour(graph, v, true, [&] (int w) {
+                    buffer.append(prefix);
+                    append_number(buffer, w + offset);
+                    buffer.push_back('\n');
+                    });
+            });
+}
+
+auto parasols::write_lad(std::ostream & stream, const Graph & graph, unsigned n_threads) -> void
+{
+    stream << graph.size() << "\n";
+
+    unsigned length = number_length(graph.size());
+    write_rows(stream, graph, n_threads, length + 1, [&] (int v, std::string & buffer) {
+            append_number(buffer, graph.degree(v) - (graph.adjacent(v, v) ? 1 : 0));
+
+            for_each_neighbour(graph, v, false, [&] (int w) {
+                    buffer.push_back(' ');
+                    append_number(buffer, w);
+                    });
+
+            buffer.push_back('\n');
+            });
+}
+
+auto parasols::write_unpermuted_binary(std::ostream & stream, const Graph & graph) -> void
+{
+    std::vector<int> order(graph.size());
+    std::iota(order.begin(), order.end(), 0);
+    write_binary(graph, order, stream);
+}
@@ -0,0 +1,47 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_GRAPH_WRITER_HH
+#define PARASOLS_GUARD_GRAPH_GRAPH_WRITER_HH 1
+
+#include <graph/graph.hh>
+
+#include <ostream>
+#include <string>
+
+namespace parasols
+{
+    /*
+     * The text writers all work the same way. Each row is turned into text
+     * by walking the set bits of its words, into large buffers rather than a
+     * line at a time. If n_threads is not 1, the rows are split into shards
+     * which are formatted in parallel and then written out in order, so the
+     * output is the same either way. If n_threads is 0, we use one thread
+     * per core. Vertices are written by position, not by label, and loops
+     * are not written.
+     */
+
+    /**
+     * Write a Graph in DIMACS format: "p edge n 0", then an "e a b" line for
+     * each edge with a < b, numbering vertices from one.
+     */
+    auto write_dimacs(std::ostream &, const Graph &, unsigned n_threads = 0) -> void;
+
+    /**
+     * Write a Graph as pairs: "n 0", then an "a b" line for each edge with a
+     * < b, numbering vertices from zero or one.
+     */
+    auto write_pairs(std::ostream &, const Graph &, bool one_indexed, unsigned n_threads = 0) -> void;
+
+    /**
+     * Write a Graph in LAD format: n, then for each vertex a line giving its
+     * degree followed by its neighbours, numbered from zero.
+     */
+    auto write_lad(std::ostream &, const Graph &, unsigned n_threads = 0) -> void;
+
+    /**
+     * Write a Graph in binary format, without permuting it.
+     */
+    auto write_unpermuted_binary(std::ostream &, const Graph &) -> void;
+}
+
+#endif
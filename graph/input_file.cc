@@ -0,0 +1,191 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/input_file.hh>
+
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace parasols;
+
+namespace
+{
+    /**
+     * How much we try to read at once from a stream. Big enough that each
+     * block is worth parsing in parallel.
+     */
+    const constexpr std::size_t block_size = 1 << 24;
+
+    /**
+     * Is this something we can't map?
+     */
+    auto must_stream(const std::string & filename) -> bool
+    {
+        if ("-" == filename)
+            return true;
+
+        /* If we can't stat it, let MappedFile explain why. */
+        struct stat st;
+        if (-1 == ::stat(filename.c_str(), &st))
+            return false;
+
+        return ! S_ISREG(st.st_mode);
+    }
+}
+
+InputFile::InputFile(const std::string & filename) :
+    _filename(filename)
+{
+    if (! must_stream(filename)) {
+        std::unique_ptr<MappedFile> mapped{ new MappedFile{ filename } };
+
+        /* A compressed file has to be read like a stream. */
+        if (Decompressor::is_compressed(mapped->data(), mapped->size()))
+            _decompressor.reset(new Decompressor{ filename, std::move(mapped) });
+        else {
+            _mapped = std::move(mapped);
+            _begin = _mapped->data();
+            _end = _mapped->data() + _mapped->size();
+            return;
+        }
+    }
+    else {
+        if ("-" == filename)
+            _fd = STDIN_FILENO;
+        else {
+            _fd = ::open(filename.c_str(), O_RDONLY);
+            if (-1 == _fd)
+                throw GraphFileError{ filename, "unable to open file" };
+        }
+
+        /* We can't tell whether a stream is compressed until we've started
+         * reading it, so what we've read so far goes to the decompressor. */
+        _buffer.resize(block_size);
+        _fill(false);
+        if (Decompressor::is_compressed(_buffer.data(), _filled)) {
+            _decompressor.reset(new Decompressor{ filename, _fd, std::string(_buffer.data(), _filled) });
+            _filled = 0;
+            _block_end = 0;
+            _eof = false;
+        }
+        else
+            return;
+    }
+
+    _buffer.resize(block_size);
+    _fill(false);
+}
+
+InputFile::~InputFile()
+{
+    /* The decompressor may be reading from our file descriptor. */
+    _decompressor.reset();
+
+    if (-1 != _fd && STDIN_FILENO != _fd)
+        ::close(_fd);
+}
+
+auto InputFile::_read_some(char * dest, std::size_t n) -> std::size_t
+{
+    if (_decompressor)
+        return _decompressor->read(dest, n);
+
+    while (true) {
+        auto r = ::read(_fd, dest, n);
+        if (-1 == r) {
+            if (EINTR == errno)
+                continue;
+            throw GraphFileError{ _filename, "error reading file" };
+        }
+
+        return r;
+    }
+}
+
+auto InputFile::_fill(bool grow) -> void
+{
+    /* Whatever followed the last block is the start of this one. */
+    std::memmove(_buffer.data(), _buffer.data() + _block_end, _filled - _block_end);
+    _filled -= _block_end;
+    _block_end = 0;
+    _cursor = 0;
+
+    while (true) {
+        while (! _eof && _filled < _buffer.size()) {
+            auto n = _read_some(_buffer.data() + _filled, _buffer.size() - _filled);
+            if (0 == n)
+                _eof = true;
+            else
+                _filled += n;
+        }
+
+        if (_eof) {
+            _block_end = _filled;
+            break;
+        }
+
+        /* Stop at the last complete line. If a single line doesn't fit,
+         * we need a bigger buffer, unless we're just looking. */
+        auto newline = static_cast<const char *>(::memrchr(_buffer.data(), '\n', _filled));
+        if (newline) {
+            _block_end = newline - _buffer.data() + 1;
+            break;
+        }
+        else if (! grow)
+            break;
+
+        _buffer.resize(_buffer.size() * 2);
+    }
+
+    _begin = _buffer.data();
+    _end = _buffer.data() + _block_end;
+}
+
+auto InputFile::next_block() -> bool
+{
+    if (_mapped || (_eof && _block_end == _filled)) {
+        _begin = _end;
+        return false;
+    }
+
+    _fill(true);
+    return _begin != _end;
+}
+
+auto InputFile::read_bytes(char * dest, std::size_t n) -> std::size_t
+{
+    if (_mapped) {
+        std::size_t k = std::min(n, _mapped->size() - _cursor);
+        std::memcpy(dest, _mapped->data() + _cursor, k);
+        _cursor += k;
+        return k;
+    }
+
+    /* Use up anything we've already read, and then go straight to the
+     * file. */
+    std::size_t k = std::min(n, _filled - _cursor);
+    std::memcpy(dest, _buffer.data() + _cursor, k);
+    _cursor += k;
+
+    while (k < n && ! _eof) {
+        auto r = _read_some(dest + k, n - k);
+        if (0 == r)
+            _eof = true;
+        else
+            k += r;
+    }
+
+    return k;
+}
+
+auto InputFile::peek(std::size_t max_bytes) const -> Tokeniser
+{
+    if (_mapped)
+        return Tokeniser{ _mapped->data(), _mapped->data() + std::min(max_bytes, _mapped->size()) };
+    else
+        return Tokeniser{ _buffer.data(), _buffer.data() + std::min(max_bytes, _filled) };
+}
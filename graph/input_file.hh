@@ -0,0 +1,159 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_INPUT_FILE_HH
+#define PARASOLS_GUARD_GRAPH_INPUT_FILE_HH 1
+
+#include <graph/graph_file_error.hh>
+#include <graph/mapped_file.hh>
+#include <graph/decompressor.hh>
+#include <graph/tokeniser.hh>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+namespace parasols
+{
+    /**
+     * A graph file, opened for reading from start to end exactly once.
+     *
+     * A regular file is mapped, and its text comes as a single block.
+     * Anything else (standard input, given as "-", or a pipe or a device) is
+     * read sequentially, and its text comes as a series of blocks, each of
+     * which ends at the end of a line, so a reader never needs to seek or to
+     * hold the whole file in memory. The start of the file is read when we
+     * are constructed, so that peek() can look at it.
+     *
+     * Gzip (and possibly zstd) compressed files, of either kind, are spotted
+     * by their magic bytes, and decompressed by a Decompressor as we go.
+     * These are then read in blocks, like a stream.
+     *
+     * Text readers work a block at a time, using next_block() or refill().
+     * Binary readers use read_bytes() instead. The two should not be mixed.
+     */
+    class InputFile
+    {
+        private:
+            std::string _filename;
+            std::unique_ptr<MappedFile> _mapped;
+            std::unique_ptr<Decompressor> _decompressor;
+            int _fd = -1;
+            bool _eof = false;
+
+            std::vector<char> _buffer;
+            std::size_t _block_end = 0, _filled = 0, _cursor = 0;
+            const char * _begin = nullptr, * _end = nullptr;
+
+            auto _fill(bool grow) -> void;
+            auto _read_some(char * dest, std::size_t n) -> std::size_t;
+
+        public:
+            /**
+             * \throw GraphFileError
+             */
+            explicit InputFile(const std::string & filename);
+
+            ~InputFile();
+
+            InputFile(const InputFile &) = delete;
+            InputFile & operator= (const InputFile &) = delete;
+
+            /**
+             * Are we being read in blocks, rather than mapped? If so, we can
+             * only be read once.
+             */
+            auto is_stream() const -> bool
+            {
+                return ! _mapped;
+            }
+
+            auto filename() const -> const std::string &
+            {
+                return _filename;
+            }
+
+            /**
+             * Up to max_bytes from the start of the file, for working out
+             * what it is, without using anything up. We may give back less
+             * than max_bytes, even if the file is longer.
+             */
+            auto peek(std::size_t max_bytes) const -> Tokeniser;
+
+            /**
+             * The current block of text. This may be empty to begin with, so
+             * readers should use refill() before looking at it.
+             */
+            auto begin() const -> const char *
+            {
+                return _begin;
+            }
+
+            auto end() const -> const char *
+            {
+                return _end;
+            }
+
+            /**
+             * Move on to the next block, returning false if there isn't one.
+             *
+             * \throw GraphFileError
+             */
+            auto next_block() -> bool;
+
+            /**
+             * If text has used up the current block, point it at the next
+             * one. Returns false if there is nothing left. Blocks end at line
+             * boundaries, so nothing a reader wants to parse is ever split.
+             *
+             * \throw GraphFileError
+             */
+            auto refill(Tokeniser & text) -> bool
+            {
+                while (text.at_end()) {
+                    if (! next_block())
+                        return false;
+                    text = Tokeniser{ _begin, _end };
+                }
+                return true;
+            }
+
+            /**
+             * Skip spaces and newlines, moving on through blocks as
+             * necessary. Returns false if there is nothing left.
+             *
+             * \throw GraphFileError
+             */
+            auto skip_whitespace(Tokeniser & text) -> bool
+            {
+                do
+                    text.skip_whitespace();
+                while (text.at_end() && refill(text));
+                return ! text.at_end();
+            }
+
+            /**
+             * Call f(begin, end) for whatever text has left of the current
+             * block, and then for each remaining block in turn.
+             *
+             * \throw GraphFileError
+             */
+            template <typename F_>
+            auto for_each_remaining_block(const Tokeniser & text, const F_ & f) -> void
+            {
+                f(text.position(), _end);
+                while (next_block())
+                    f(_begin, _end);
+            }
+
+            /**
+             * Read up to n bytes, returning how many we got, which is only
+             * less than n at the end of the file.
+             *
+             * \throw GraphFileError
+             */
+            auto read_bytes(char * dest, std::size_t n) -> std::size_t;
+    };
+}
+
+#endif
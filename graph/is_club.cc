@@ -2,7 +2,6 @@
 
 #include <graph/is_club.hh>
 #include <graph/kneighbours.hh>
-#include <limits>
 
 using namespace parasols;
 
@@ -10,16 +9,20 @@ auto
 parasols::is_club(const Graph & graph, int k, const std::vector<int> & members) -> bool
 {
     std::vector<int> restrict_to((graph.size()));
-    for (auto & m : members)
+    std::vector<BitWord> members_words(graph.words_per_row(), 0);
+    for (auto & m : members) {
         restrict_to[m] = 1;
+        members_words[m / bits_per_word] |= (BitWord{ 1 } << (m % bits_per_word));
+    }
 
     KNeighbours distances(graph, k, &restrict_to);
 
-    for (auto & i : members)
-        for (auto & j : members)
-            if (i != j && distances.vertices[i].distances[j].distance <= 0)
+    for (auto & i : members) {
+        const BitWord * within = distances.within_words(i);
+        for (int w = 0 ; w < graph.words_per_row() ; ++w)
+            if (members_words[w] & ~within[w])
                 return false;
+    }
 
     return true;
 }
-
@@ -0,0 +1,17 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/is_independent_set.hh>
+
+using namespace parasols;
+
+auto
+parasols::is_independent_set(const Graph & graph, const std::set<int> & members) -> bool
+{
+    for (auto & a : members)
+        for (auto & b : members)
+            if (a != b && graph.adjacent(a, b))
+                return false;
+
+    return true;
+}
+
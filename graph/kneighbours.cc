@@ -1,81 +1,64 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 #include <graph/kneighbours.hh>
+#include <graph/permute_graph.hh>
+
+#include <algorithm>
 
 using namespace parasols;
 
 KNeighbours::KNeighbours(const Graph & graph, const int nk, const std::vector<int> * maybe_restrict) :
-    vertices(graph.size())
+    _words_per_row(graph.words_per_row()),
+    _within(std::vector<BitWord>::size_type(graph.size()) * _words_per_row, 0)
 {
-    for (auto & d : vertices) {
-        d.firsts.resize(nk + 1);
-        for (auto & f : d.firsts)
-            f = -1;
+    /* which vertices may we use? */
+    std::vector<BitWord> allowed(_words_per_row, 0);
+    for (int v = 0 ; v < graph.size() ; ++v)
+        if (! maybe_restrict || maybe_restrict->at(v))
+            allowed[v / bits_per_word] |= (BitWord{ 1 } << (v % bits_per_word));
 
-        d.distances.resize(graph.size());
-    }
+    for_each_row_range(graph.size(), [&] (int begin, int end) {
+            std::vector<BitWord> frontier(_words_per_row), next(_words_per_row);
 
-    /* build up distance 1 lists */
-    for (int i = 0 ; i < graph.size() ; ++i) {
-        if (maybe_restrict && ! maybe_restrict->at(i))
-            continue;
+            for (int i = begin ; i < end ; ++i) {
+                if (! (allowed[i / bits_per_word] & (BitWord{ 1 } << (i % bits_per_word))))
+                    continue;
 
-        int prev = -1;
-        for (int j = 0 ; j < graph.size() ; ++j) {
-            if (maybe_restrict && ! maybe_restrict->at(j))
-                continue;
+                BitWord * reached = &_within[std::vector<BitWord>::size_type(i) * _words_per_row];
+                reached[i / bits_per_word] |= (BitWord{ 1 } << (i % bits_per_word));
 
-            if (i == j) {
-                vertices[i].firsts[0] = i;
-                vertices[i].distances[j].distance = 0;
-                vertices[i].distances[j].next = -1;
-            }
-            else if (graph.adjacent(i, j)) {
-                if (-1 == vertices[i].firsts[1]) {
-                    vertices[i].firsts[1] = j;
-                    vertices[i].distances[j].distance = 1;
-                    vertices[i].distances[j].next = -1;
-                    prev = j;
-                }
-                else {
-                    vertices[i].distances[prev].next = j;
-                    vertices[i].distances[j].distance = 1;
-                    vertices[i].distances[j].next = -1;
-                    prev = j;
-                }
-            }
-            else {
-                vertices[i].distances[j].distance = -1;
-                vertices[i].distances[j].next = -1;
-            }
-        }
-    }
+                std::fill(frontier.begin(), frontier.end(), 0);
+                frontier[i / bits_per_word] |= (BitWord{ 1 } << (i % bits_per_word));
 
-    /* build up distance k lists */
-    for (int k = 2 ; k <= nk ; ++k) {
-        // for each vertex i...
-        for (int i = 0 ; i < graph.size() ; ++i) {
-            if (maybe_restrict && ! maybe_restrict->at(i))
-                continue;
+                /* each layer is everything adjacent to the previous layer
+                 * that we haven't already seen */
+                for (int k = 1 ; k <= nk ; ++k) {
+                    std::fill(next.begin(), next.end(), 0);
 
-            int prev = -1;
-            // for each vertex a at distance k - 1 from i...
-            for (int a = vertices[i].firsts[k - 1] ; a != -1 ; a = vertices[i].distances[a].next) {
-                // for each vertex j at distance 1 from a...
-                for (int j = vertices[a].firsts[1] ; j != -1 ; j = vertices[a].distances[j].next) {
-                    // are i and j currently infinitely far apart?
-                    if (vertices[i].distances[j].distance == -1) {
-                        // distance from i to j is now k, via a.
-                        vertices[i].distances[j].distance = k;
-                        if (-1 == prev)
-                            vertices[i].firsts[k] = j;
-                        else
-                            vertices[i].distances[prev].next = j;
-                        prev = j;
+                    for (int w = 0 ; w < _words_per_row ; ++w) {
+                        BitWord bits = frontier[w];
+                        while (0 != bits) {
+                            int b = __builtin_ctzll(bits);
+                            bits &= bits - 1;
+
+                            const BitWord * row = graph.neighbourhood_words(w * bits_per_word + b);
+                            for (int x = 0 ; x < _words_per_row ; ++x)
+                                next[x] |= row[x];
+                        }
+                    }
+
+                    BitWord any = 0;
+                    for (int w = 0 ; w < _words_per_row ; ++w) {
+                        next[w] &= allowed[w] & ~reached[w];
+                        reached[w] |= next[w];
+                        any |= next[w];
                     }
+
+                    if (0 == any)
+                        break;
+
+                    std::swap(frontier, next);
                 }
             }
-        }
-    }
+        });
 }
-
@@ -5,27 +5,51 @@
 
 #include <graph/graph.hh>
 #include <vector>
-#include <set>
 
 namespace parasols
 {
-    struct VertexDistance
+    /**
+     * For each vertex, the set of vertices within distance k of it,
+     * including itself, stored as one bit-packed row per vertex.
+     *
+     * Rows are found by a breadth first search from each vertex in turn,
+     * where each layer is a bitset: the next frontier is the union of the
+     * neighbourhoods of the current frontier, less everything already
+     * reached. Sources are shared out between threads.
+     *
+     * If maybe_restrict is given, only vertices v with (*maybe_restrict)[v]
+     * non-zero are used, both as sources and as intermediate vertices, and
+     * the rows of every other vertex are left empty.
+     */
+    class KNeighbours
     {
-        int distance;
-        int next;
-    };
+        private:
+            int _words_per_row;
+            std::vector<BitWord> _within;
 
-    struct VertexInformation
-    {
-        std::vector<int> firsts;
-        std::vector<VertexDistance> distances;
-    };
+        public:
+            KNeighbours(const Graph & graph, const int k, const std::vector<int> * maybe_restrict = nullptr);
 
-    struct KNeighbours
-    {
-        std::vector<VertexInformation> vertices;
+            /**
+             * The vertices within distance k of v, as words_per_row() words.
+             */
+            auto within_words(int v) const -> const BitWord *
+            {
+                return &_within[std::vector<BitWord>::size_type(v) * _words_per_row];
+            }
+
+            /**
+             * Is w within distance k of v?
+             */
+            auto within(int v, int w) const -> bool
+            {
+                return within_words(v)[w / bits_per_word] & (BitWord{ 1 } << (w % bits_per_word));
+            }
 
-        KNeighbours(const Graph & graph, const int k, const std::vector<int> * maybe_restrict = nullptr);
+            auto words_per_row() const -> int
+            {
+                return _words_per_row;
+            }
     };
 }
 
@@ -2,55 +2,79 @@
 
 #include <graph/lad.hh>
 #include <graph/graph.hh>
-#include <fstream>
+#include <graph/input_file.hh>
+#include <graph/tokeniser.hh>
 
 using namespace parasols;
 
 namespace
 {
-    auto read_word(std::ifstream & infile) -> int
+    auto read_word(InputFile & input, Tokeniser & text, int & x) -> bool
     {
-        int x;
-        infile >> x;
-        return x;
+        input.skip_whitespace(text);
+        return text.read_signed_number(x);
     }
-}
-
-auto parasols::read_lad(const std::string & filename, const GraphOptions & options) -> Graph
-{
-    Graph result(0, false);
 
-    std::ifstream infile{ filename };
-    if (! infile)
-        throw GraphFileError{ filename, "unable to open file" };
+    /**
+     * Parse a LAD file, passing the size and then each edge to the supplied
+     * callbacks.
+     */
+    template <typename SetSize_, typename AddEdge_>
+    auto read_lad_edges(InputFile & input, const GraphOptions & options,
+            const SetSize_ & set_size, const AddEdge_ & add_edge) -> void
+    {
+        const std::string & filename = input.filename();
+        Tokeniser text{ input.begin(), input.end() };
 
-    result.resize(read_word(infile));
-    if (! infile)
-        throw GraphFileError{ filename, "error reading size" };
+        int size;
+        if (! read_word(input, text, size))
+            throw GraphFileError{ filename, "error reading size" };
+        set_size(size);
 
-    for (int r = 0 ; r < result.size() ; ++r) {
-        int c_end = read_word(infile);
-        if (! infile)
-            throw GraphFileError{ filename, "error reading edges count" };
+        for (int r = 0 ; r < size ; ++r) {
+            int c_end;
+            if (! read_word(input, text, c_end))
+                throw GraphFileError{ filename, "error reading edges count" };
 
-        for (int c = 0 ; c < c_end ; ++c) {
-            int e = read_word(infile);
+            for (int c = 0 ; c < c_end ; ++c) {
+                int e;
+                if (! read_word(input, text, e))
+                    throw GraphFileError{ filename, "error reading edge" };
 
-            if (e < 0 || e >= result.size())
-                throw GraphFileError{ filename, "edge index out of bounds" };
-            else if (r == e && ! test(options, GraphOptions::AllowLoops))
-                throw GraphFileError{ filename, "loop on vertex " + std::to_string(r) };
+                if (e < 0 || e >= size)
+                    throw GraphFileError{ filename, "edge index out of bounds" };
+                else if (r == e && ! test(options, GraphOptions::AllowLoops))
+                    throw GraphFileError{ filename, "loop on vertex " + std::to_string(r) };
 
-            result.add_edge(r, e);
+                add_edge(r, e);
+            }
         }
+
+        if (input.skip_whitespace(text))
+            throw GraphFileError{ filename, "EOF not reached, next text is \"" + text.read_word().rest() + "\"" };
     }
+}
 
-    std::string rest;
-    if (infile >> rest)
-        throw GraphFileError{ filename, "EOF not reached, next text is \"" + rest + "\"" };
-    if (! infile.eof())
-        throw GraphFileError{ filename, "EOF not reached" };
+auto parasols::read_lad(InputFile & input, const GraphOptions & options) -> Graph
+{
+    Graph result(0, false);
+
+    read_lad_edges(input, options,
+            [&] (int size) { result.resize(size); },
+            [&] (int a, int b) { result.add_edge(a, b); });
 
     return result;
 }
 
+auto parasols::read_lad(const std::string & filename, const GraphOptions & options) -> Graph
+{
+    InputFile input{ filename };
+    return read_lad(input, options);
+}
+
+auto parasols::read_sparse_lad(const std::string & filename, const GraphOptions & options) -> SparseGraph
+{
+    return read_sparse_graph(filename, false, [&] (InputFile & input, const auto & set_size, const auto & add_edge) {
+            read_lad_edges(input, options, set_size, add_edge);
+            });
+}
@@ -4,6 +4,8 @@
 #define PARASOLS_GUARD_GRAPH_LAD_HH 1
 
 #include <graph/graph.hh>
+#include <graph/input_file.hh>
+#include <graph/sparse_graph.hh>
 #include <graph/graph_file_error.hh>
 #include <string>
 
@@ -15,6 +17,21 @@ namespace parasols
      * \throw GraphFileError
      */
     auto read_lad(const std::string & filename, const GraphOptions & options) -> Graph;
+
+    /**
+     * Read a LAD format file from an InputFile which has not yet been
+     * used.
+     *
+     * \throw GraphFileError
+     */
+    auto read_lad(InputFile & input, const GraphOptions &) -> Graph;
+
+    /**
+     * Read a LAD format file into a SparseGraph.
+     *
+     * \throw GraphFileError
+     */
+    auto read_sparse_lad(const std::string & filename, const GraphOptions & options) -> SparseGraph;
 }
 
 #endif
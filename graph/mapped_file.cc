@@ -0,0 +1,51 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/mapped_file.hh>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace parasols;
+
+MappedFile::MappedFile(const std::string & filename)
+{
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (-1 == fd)
+        throw GraphFileError{ filename, "unable to open file" };
+
+    struct stat st;
+    if (-1 == ::fstat(fd, &st)) {
+        ::close(fd);
+        throw GraphFileError{ filename, "unable to stat file" };
+    }
+
+    if (! S_ISREG(st.st_mode)) {
+        ::close(fd);
+        throw GraphFileError{ filename, "not a regular file" };
+    }
+
+    _size = st.st_size;
+
+    /* mmap doesn't like zero length mappings, and an empty file has nothing
+     * to map anyway. */
+    if (0 != _size) {
+        void * mapped = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED == mapped) {
+            ::close(fd);
+            throw GraphFileError{ filename, "unable to map file" };
+        }
+
+        ::madvise(mapped, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const char *>(mapped);
+    }
+
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data)
+        ::munmap(const_cast<char *>(_data), _size);
+}
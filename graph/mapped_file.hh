@@ -0,0 +1,52 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_MAPPED_FILE_HH
+#define PARASOLS_GUARD_GRAPH_MAPPED_FILE_HH 1
+
+#include <graph/graph_file_error.hh>
+
+#include <string>
+#include <cstddef>
+
+namespace parasols
+{
+    /**
+     * A read-only memory mapping of an entire file, which is unmapped when we
+     * go away.
+     */
+    class MappedFile
+    {
+        private:
+            const char * _data = nullptr;
+            std::size_t _size = 0;
+
+        public:
+            /**
+             * \throw GraphFileError
+             */
+            explicit MappedFile(const std::string & filename);
+
+            ~MappedFile();
+
+            MappedFile(const MappedFile &) = delete;
+            MappedFile & operator= (const MappedFile &) = delete;
+
+            /**
+             * The contents of the file. Not null terminated.
+             */
+            auto data() const -> const char *
+            {
+                return _data;
+            }
+
+            /**
+             * The size of the file, in bytes.
+             */
+            auto size() const -> std::size_t
+            {
+                return _size;
+            }
+    };
+}
+
+#endif
@@ -3,99 +3,222 @@
 #include <graph/metis.hh>
 #include <graph/graph.hh>
 #include <graph/graph_file_error.hh>
-#include <boost/regex.hpp>
-#include <fstream>
+#include <graph/input_file.hh>
+#include <graph/tokeniser.hh>
 
 using namespace parasols;
 
-auto parasols::read_metis(const std::string & filename, const GraphOptions & options) -> Graph
+namespace
 {
-    Graph result(0, true);
+    /**
+     * The rows from a chunk of a METIS file. Row r's edges are destinations
+     * [row_ends[r - 1], row_ends[r]). If there was a problem, the edges from
+     * the offending line up to the problem follow the last complete row.
+     */
+    struct MetisChunk
+    {
+        std::vector<int> destinations;
+        std::vector<std::size_t> row_ends;
+        std::vector<bool> row_empty;
+        std::string error;
+    };
+
+    /**
+     * Is this a comment line?
+     */
+    auto is_comment(const Tokeniser & line) -> bool
+    {
+        return ! line.at_end() && '%' == line.peek();
+    }
 
-    std::ifstream infile{ filename };
-    if (! infile)
-        throw GraphFileError{ filename, "unable to open file" };
-
-    /* Lines are comments, a problem description (contains the number of
-     * vertices), or an edge. */
-    static const boost::regex
-        comment{ R"(%.*)" },
-        problem{ R"((\d+)\s+(\d+)(\s+(\d+)(\s+(\d+))?)?)" };
-
-    bool weighted_edges = false;
-    std::string line;
-    while (std::getline(infile, line)) {
-        if (line.empty())
-            continue;
-
-        boost::smatch match;
-        if (regex_match(line, match, comment)) {
-            /* comment */
-        }
-        else if (regex_match(line, match, problem)) {
-            result.resize(std::stoi(match.str(1)));
-            if (! match.str(4).empty()) {
-                if (match.str(4) == "1")
-                    weighted_edges = true;
-                else if (match.str(4) != "0")
-                    throw GraphFileError{ filename, "unsupported fmt " + match.str(4) + " is not 0 or 1" };
+    /**
+     * Is this a (\d+)\s+(\d+)(\s+(\d+)(\s+(\d+))?)? problem line? If so,
+     * extract the number of vertices, and the fmt and ncon fields as text.
+     */
+    auto problem_line(Tokeniser line, int & size, std::string & fmt, std::string & ncon) -> bool
+    {
+        int n;
+        if (! (line.read_number(size) && line.skip_spaces() && line.read_number(n)))
+            return false;
+
+        if (line.skip_spaces()) {
+            auto start = line.position();
+            if (! line.read_number(n))
+                return false;
+            fmt.assign(start, line.position());
+
+            if (line.skip_spaces()) {
+                start = line.position();
+                if (! line.read_number(n))
+                    return false;
+                ncon.assign(start, line.position());
             }
-
-            if (! match.str(6).empty())
-                if (match.str(6) != "0")
-                    throw GraphFileError{ filename, "unsupported ncon " + match.str(6) + " is not 0" };
-
-            break;
         }
-        else
-            throw GraphFileError{ filename, "could not parse first line" };
-    }
 
-    if (0 == result.size())
-        throw GraphFileError{ filename, "no problem line found" };
+        return line.at_end();
+    }
 
-    int row = 0;
-    while (std::getline(infile, line)) {
-        boost::smatch match;
-        if (regex_match(line, match, comment)) {
-            /* comment */
-        }
-        else {
-            ++row;
-            std::stringstream line_s{ line };
-            int e;
-            while (line_s >> e) {
-                if (e > result.size() || e < 1)
-                    throw GraphFileError{ filename, "bad edge destination" };
-
-                if (e == row && ! test(options, GraphOptions::AllowLoops))
-                    throw GraphFileError{ filename, "loop detected" };
-
-                result.add_edge(row - 1, e - 1);
-                if (weighted_edges)
-                    line_s >> e;
+    /**
+     * Parse a chunk of vertex lines. Each non-comment line is a row. Loops
+     * can't be detected until we know which row is which, so that is left to
+     * the caller.
+     */
+    auto parse_chunk(const char * begin, const char * end, int size, bool weighted_edges, MetisChunk & chunk) -> void
+    {
+        Tokeniser text{ begin, end };
+        while (! text.at_end()) {
+            auto line = text.next_line();
+            if (is_comment(line))
+                continue;
+
+            bool empty = line.at_end();
+            while (true) {
+                line.skip_spaces();
+                if (line.at_end())
+                    break;
+
+                int e;
+                if (! line.read_signed_number(e)) {
+                    chunk.error = "bad edges line";
+                    return;
+                }
+
+                if (e > size || e < 1) {
+                    chunk.error = "bad edge destination";
+                    return;
+                }
+
+                chunk.destinations.push_back(e - 1);
+
+                if (weighted_edges) {
+                    line.skip_spaces();
+                    if (line.at_end())
+                        break;
+                    if (! line.read_signed_number(e)) {
+                        chunk.error = "bad edges line";
+                        return;
+                    }
+                }
             }
 
-            if (! line_s.eof())
-                throw GraphFileError{ filename, "bad edges line" };
+            chunk.row_ends.push_back(chunk.destinations.size());
+            chunk.row_empty.push_back(empty);
         }
-
-        if (row == result.size())
-            break;
     }
 
-    while (std::getline(infile, line)) {
-        boost::smatch match;
-        if ((! line.empty()) && (! regex_match(line, match, comment)))
-            throw GraphFileError{ filename, "trailing non-empty lines" };
+    /**
+     * Parse a METIS file, passing the size and then each edge to the supplied
+     * callbacks.
+     */
+    template <typename SetSize_, typename AddEdge_>
+    auto read_metis_edges(InputFile & input, const GraphOptions & options,
+            const SetSize_ & set_size, const AddEdge_ & add_edge) -> void
+    {
+        int size = 0;
+
+        const std::string & filename = input.filename();
+        Tokeniser text{ input.begin(), input.end() };
+
+        /* Lines are comments, a problem description (contains the number of
+         * vertices), or an edge. */
+        bool weighted_edges = false;
+        while (input.refill(text)) {
+            auto line = text.next_line();
+            if (line.at_end())
+                continue;
+
+            std::string fmt, ncon;
+            if (is_comment(line)) {
+                /* comment */
+            }
+            else if (problem_line(line, size, fmt, ncon)) {
+                if (! fmt.empty()) {
+                    if (fmt == "1")
+                        weighted_edges = true;
+                    else if (fmt != "0")
+                        throw GraphFileError{ filename, "unsupported fmt " + fmt + " is not 0 or 1" };
+                }
+
+                if (! ncon.empty())
+                    if (ncon != "0")
+                        throw GraphFileError{ filename, "unsupported ncon " + ncon + " is not 0" };
+
+                break;
+            }
+            else
+                throw GraphFileError{ filename, "could not parse first line" };
+        }
+
+        if (0 == size)
+            throw GraphFileError{ filename, "no problem line found" };
+
+        set_size(size);
+
+        /* Now we know which row is which, go through in order. Once we've
+         * seen every row, anything else must be empty. */
+        int row = 0;
+        input.for_each_remaining_block(text, [&] (const char * begin, const char * end) {
+                auto chunks = parse_chunks<MetisChunk>(begin, end,
+                        [&] (const char * chunk_begin, const char * chunk_end, MetisChunk & chunk) {
+                            parse_chunk(chunk_begin, chunk_end, size, weighted_edges, chunk);
+                        });
+
+                for (auto & chunk : chunks) {
+                    std::size_t d = 0;
+                    for (unsigned r = 0 ; r <= chunk.row_ends.size() ; ++r) {
+                        bool partial = (r == chunk.row_ends.size());
+                        if (partial && chunk.error.empty())
+                            break;
+
+                        if (row >= size) {
+                            if (partial || ! chunk.row_empty[r])
+                                throw GraphFileError{ filename, "trailing non-empty lines" };
+                            continue;
+                        }
+
+                        std::size_t d_end = partial ? chunk.destinations.size() : chunk.row_ends[r];
+                        for ( ; d != d_end ; ++d) {
+                            int e = chunk.destinations[d];
+                            if (e == row && ! test(options, GraphOptions::AllowLoops))
+                                throw GraphFileError{ filename, "loop detected" };
+                            add_edge(row, e);
+                        }
+
+                        if (partial)
+                            throw GraphFileError{ filename, chunk.error };
+
+                        ++row;
+                    }
+
+                    chunk = MetisChunk();
+                }
+            });
+
+        if (row != size)
+            throw GraphFileError{ filename, "not enough lines read" };
     }
+}
 
-    if (row != result.size())
-        throw GraphFileError{ filename, "not enough lines read" };
+auto parasols::read_metis(InputFile & input, const GraphOptions & options) -> Graph
+{
+    Graph result(0, true);
 
-    if (! infile.eof())
-        throw GraphFileError{ filename, "error reading file" };
+    read_metis_edges(input, options,
+            [&] (int size) { result.resize(size); },
+            [&] (int a, int b) { result.add_edge(a, b); });
 
     return result;
 }
 
+auto parasols::read_metis(const std::string & filename, const GraphOptions & options) -> Graph
+{
+    InputFile input{ filename };
+    return read_metis(input, options);
+}
+
+auto parasols::read_sparse_metis(const std::string & filename, const GraphOptions & options) -> SparseGraph
+{
+    return read_sparse_graph(filename, true, [&] (InputFile & input, const auto & set_size, const auto & add_edge) {
+            read_metis_edges(input, options, set_size, add_edge);
+            });
+}
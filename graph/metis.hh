@@ -4,6 +4,8 @@
 #define PARASOLS_GUARD_GRAPH_METIS_HH 1
 
 #include <graph/graph.hh>
+#include <graph/input_file.hh>
+#include <graph/sparse_graph.hh>
 #include <string>
 
 namespace parasols
@@ -14,6 +16,21 @@ namespace parasols
      * \throw GraphFileError
      */
     auto read_metis(const std::string & filename, const GraphOptions &) -> Graph;
+
+    /**
+     * Read a METIS format file from an InputFile which has not yet been
+     * used.
+     *
+     * \throw GraphFileError
+     */
+    auto read_metis(InputFile & input, const GraphOptions &) -> Graph;
+
+    /**
+     * Read a METIS format file into a SparseGraph.
+     *
+     * \throw GraphFileError
+     */
+    auto read_sparse_metis(const std::string & filename, const GraphOptions &) -> SparseGraph;
 }
 
 #endif
@@ -1,128 +1,123 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 #include <graph/min_width_sort.hh>
+#include <graph/degree_elimination.hh>
 
 #include <algorithm>
 
 using namespace parasols;
 
-auto parasols::min_width_sort(const Graph & graph, std::vector<int> & p, bool reverse) -> void
+namespace
 {
-    // pre-calculate degrees
-    std::vector<int> degrees;
-    std::transform(p.begin(), p.end(), std::back_inserter(degrees),
-            [&] (int v) { return graph.degree(v); });
-
-    std::vector<int> result;
-
-    while (! p.empty()) {
-        auto min = std::min_element(p.begin(), p.end(),
-                [&] (int a, int b) { return degrees[a] < degrees[b] || (degrees[a] == degrees[b] && a > b); });
-
-        result.push_back(*min);
-
+    /**
+     * Support for MWSI: for each vertex, the sum of the current degrees of
+     * its remaining neighbours.
+     */
+    auto initial_exdegrees(const DegreeElimination & e, const std::vector<int> & p) -> std::vector<long long>
+    {
+        std::vector<long long> exdegrees(e.graph.size(), 0);
         for (auto & v : p)
-            if (graph.adjacent(*min, v))
-                --degrees[v];
-
-        p.erase(min);
+            e.for_each_remaining_neighbour(v, [&] (int u) { exdegrees[v] += e.degrees[u]; });
+        return exdegrees;
     }
 
-    if (reverse)
-        std::swap(result, p);
-    else
-        for (auto r = result.rbegin() ; r != result.rend() ; ++r)
-            p.push_back(*r);
-}
-
-auto parasols::mwsi_sort(const Graph & graph, std::vector<int> & p) -> void
-{
-    // pre-calculate degrees
-    std::vector<int> degrees;
-    std::transform(p.begin(), p.end(), std::back_inserter(degrees),
-            [&] (int v) { return graph.degree(v); });
-
-    auto unadulterated_degrees = degrees;
+    /**
+     * Keep exdegrees up to date after v, whose degree was v_degree, has been
+     * removed, lowering the degrees of the vertices in lowered by one. Each
+     * remaining vertex loses one for each lowered neighbour, which we either
+     * push out from the lowered vertices or pull in from every remaining
+     * vertex, whichever looks cheaper.
+     */
+    auto update_exdegrees(const DegreeElimination & e, int v_degree, const std::vector<int> & lowered,
+            std::vector<BitWord> & lowered_bits, std::vector<long long> & exdegrees) -> void
+    {
+        long long push_cost = 0, n_remaining = 0;
+        for (auto & u : lowered) {
+            exdegrees[u] -= v_degree;
+            push_cost += e.graph.words_per_row() + e.degrees[u];
+        }
 
-    // pre-calculate supports
-    std::vector<int> exdegrees((graph.size()));
-    for (int i = 0 ; i < graph.size() ; ++i)
-        for (int j = 0 ; j < graph.size() ; ++j)
-            if (graph.adjacent(i, j))
-                exdegrees[i] += degrees[j];
+        for (auto & w : e.remaining)
+            n_remaining += __builtin_popcountll(w);
 
-    std::vector<int> result;
+        if (push_cost <= n_remaining * e.graph.words_per_row()) {
+            for (auto & u : lowered)
+                e.for_each_remaining_neighbour(u, [&] (int t) { --exdegrees[t]; });
+        }
+        else {
+            for (auto & u : lowered)
+                lowered_bits[u / bits_per_word] |= (BitWord{ 1 } << (u % bits_per_word));
+
+            for (int w = 0 ; w < e.graph.words_per_row() ; ++w) {
+                BitWord bits = e.remaining[w];
+                while (0 != bits) {
+                    int b = __builtin_ctzll(bits);
+                    bits &= bits - 1;
+
+                    int t = w * bits_per_word + b;
+                    const BitWord * row = e.graph.neighbourhood_words(t);
+                    for (int x = 0 ; x < e.graph.words_per_row() ; ++x)
+                        exdegrees[t] -= __builtin_popcountll(row[x] & lowered_bits[x]);
+                }
+            }
+
+            for (auto & u : lowered)
+                lowered_bits[u / bits_per_word] = 0;
+        }
+    }
 
-    while (! p.empty()) {
-        auto min = std::min_element(p.begin(), p.end(),
-                [&] (int a, int b) { return
-                (degrees[a] < degrees[b]) ||
-                (degrees[a] == degrees[b] && exdegrees[a] < exdegrees[b]) ||
-                (degrees[a] == degrees[b] && exdegrees[a] == exdegrees[b] && a < b); });
+    auto mwsi_common(const Graph & graph, std::vector<int> & p, bool static_support) -> void
+    {
+        DegreeElimination e{ graph, p };
+        auto unadulterated_degrees = e.degrees;
+        auto exdegrees = initial_exdegrees(e, p);
 
-        result.push_back(*min);
+        std::vector<int> lowered;
+        lowered.reserve(p.size());
+        std::vector<BitWord> lowered_bits(graph.words_per_row(), 0);
 
-        for (auto & v : p)
-            if (graph.adjacent(*min, v))
-                --degrees[v];
+        for (unsigned i = 0 ; i < p.size() ; ++i) {
+            int v = e.pick_lowest([&] (int a, int b) { return
+                    (exdegrees[a] < exdegrees[b]) ||
+                    (exdegrees[a] == exdegrees[b] && a < b); });
 
-        p.erase(min);
+            int v_degree = e.degrees[v];
+            e.remove(v, lowered);
 
-        for (int i = 0 ; i < graph.size() ; ++i) {
-            exdegrees[i] = 0;
-            for (auto & v : p)
-                if (graph.adjacent(i, v))
-                    exdegrees[i] += degrees[v];
+            if (! static_support)
+                update_exdegrees(e, v_degree, lowered, lowered_bits, exdegrees);
         }
-    }
 
-    for (auto r = result.rbegin() ; r != result.rend() ; ++r)
-        p.push_back(*r);
+        std::copy(e.result.rbegin(), e.result.rend(), p.begin());
 
-    // now the sort step
-    std::stable_sort(p.begin(), p.begin() + (p.size() / 4),
-                [&] (int a, int b) { return (unadulterated_degrees[a] > unadulterated_degrees[b]); });
+        // now the sort step
+        std::stable_sort(p.begin(), p.begin() + (p.size() / 4),
+                    [&] (int a, int b) { return (unadulterated_degrees[a] > unadulterated_degrees[b]); });
+    }
 }
 
-auto parasols::mwssi_sort(const Graph & graph, std::vector<int> & p) -> void
+auto parasols::min_width_sort(const Graph & graph, std::vector<int> & p, bool reverse) -> void
 {
-    // pre-calculate degrees
-    std::vector<int> degrees;
-    std::transform(p.begin(), p.end(), std::back_inserter(degrees),
-            [&] (int v) { return graph.degree(v); });
-
-    auto unadulterated_degrees = degrees;
-
-    // pre-calculate supports
-    std::vector<int> exdegrees((graph.size()));
-    for (int i = 0 ; i < graph.size() ; ++i)
-        for (int j = 0 ; j < graph.size() ; ++j)
-            if (graph.adjacent(i, j))
-                exdegrees[i] += degrees[j];
+    DegreeElimination e{ graph, p };
 
-    std::vector<int> result;
-
-    while (! p.empty()) {
-        auto min = std::min_element(p.begin(), p.end(),
-                [&] (int a, int b) { return
-                (degrees[a] < degrees[b]) ||
-                (degrees[a] == degrees[b] && exdegrees[a] < exdegrees[b]) ||
-                (degrees[a] == degrees[b] && exdegrees[a] == exdegrees[b] && a < b); });
-
-        result.push_back(*min);
-
-        for (auto & v : p)
-            if (graph.adjacent(*min, v))
-                --degrees[v];
+    std::vector<int> lowered;
+    lowered.reserve(p.size());
 
-        p.erase(min);
-    }
+    for (unsigned i = 0 ; i < p.size() ; ++i)
+        e.remove(e.pick_lowest([] (int a, int b) { return a > b; }), lowered);
 
-    for (auto r = result.rbegin() ; r != result.rend() ; ++r)
-        p.push_back(*r);
+    if (reverse)
+        std::copy(e.result.begin(), e.result.end(), p.begin());
+    else
+        std::copy(e.result.rbegin(), e.result.rend(), p.begin());
+}
 
-    // now the sort step
-    std::stable_sort(p.begin(), p.begin() + (p.size() / 4),
-                [&] (int a, int b) { return (unadulterated_degrees[a] > unadulterated_degrees[b]); });
+auto parasols::mwsi_sort(const Graph & graph, std::vector<int> & p) -> void
+{
+    mwsi_common(graph, p, false);
 }
 
+auto parasols::mwssi_sort(const Graph & graph, std::vector<int> & p) -> void
+{
+    mwsi_common(graph, p, true);
+}
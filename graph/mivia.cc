@@ -3,40 +3,42 @@
 #include <graph/mivia.hh>
 #include <graph/graph.hh>
 #include <graph/graph_file_error.hh>
-#include <fstream>
+#include <graph/input_file.hh>
 
 using namespace parasols;
 
 namespace
 {
-    auto read_word(std::ifstream & infile) -> int
+    auto read_word(InputFile & input, int & x) -> bool
     {
-        unsigned char a, b;
-        a = static_cast<unsigned char>(infile.get());
-        b = static_cast<unsigned char>(infile.get());
-        return int(a) | (int(b) << 8);
+        unsigned char ab[2];
+        if (2 != input.read_bytes(reinterpret_cast<char *>(ab), 2))
+            return false;
+        x = int(ab[0]) | (int(ab[1]) << 8);
+        return true;
     }
 }
 
-auto parasols::read_mivia(const std::string & filename, const GraphOptions & options) -> Graph
+auto parasols::read_mivia(InputFile & input, const GraphOptions & options) -> Graph
 {
     Graph result(0, false);
 
-    std::ifstream infile{ filename };
-    if (! infile)
-        throw GraphFileError{ filename, "unable to open file" };
+    const std::string & filename = input.filename();
 
-    result.resize(read_word(infile));
-    if (! infile)
+    int size;
+    if (! read_word(input, size))
         throw GraphFileError{ filename, "error reading size" };
+    result.resize(size);
 
     for (int r = 0 ; r < result.size() ; ++r) {
-        int c_end = read_word(infile);
-        if (! infile)
+        int c_end;
+        if (! read_word(input, c_end))
             throw GraphFileError{ filename, "error reading edges count" };
 
         for (int c = 0 ; c < c_end ; ++c) {
-            int e = read_word(infile);
+            int e;
+            if (! read_word(input, e))
+                throw GraphFileError{ filename, "error reading edge" };
 
             if (e < 0 || e >= result.size())
                 throw GraphFileError{ filename, "edge index out of bounds" };
@@ -47,10 +49,15 @@ auto parasols::read_mivia(const std::string & filename, const GraphOptions & opt
         }
     }
 
-    infile.peek();
-    if (! infile.eof())
+    char extra;
+    if (0 != input.read_bytes(&extra, 1))
         throw GraphFileError{ filename, "EOF not reached" };
 
     return result;
 }
 
+auto parasols::read_mivia(const std::string & filename, const GraphOptions & options) -> Graph
+{
+    InputFile input{ filename };
+    return read_mivia(input, options);
+}
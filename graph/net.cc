@@ -3,86 +3,151 @@
 #include <graph/net.hh>
 #include <graph/graph.hh>
 #include <graph/graph_file_error.hh>
-#include <boost/regex.hpp>
-#include <fstream>
+#include <graph/input_file.hh>
+#include <graph/tokeniser.hh>
 
 using namespace parasols;
 
-auto parasols::read_net(const std::string & filename, const GraphOptions & options) -> Graph
+namespace
+{
+    /**
+     * Is this line \*\s*word?
+     */
+    auto star_line(Tokeniser line, const char * word) -> bool
+    {
+        if (! line.skip_char('*'))
+            return false;
+        line.skip_spaces();
+        return line.equals(word);
+    }
+
+    /**
+     * Is this line \d+\s+".*"?
+     */
+    auto description_line(Tokeniser line) -> bool
+    {
+        int n;
+        return line.read_number(n) && line.skip_spaces() && line.skip_char('"') && line.skip_trailing_char('"');
+    }
+
+    /**
+     * Is this line \*\s*Vertices\s+(\d+)?
+     */
+    auto problem_line(Tokeniser line, int & size) -> bool
+    {
+        if (! line.skip_char('*'))
+            return false;
+        line.skip_spaces();
+        return line.skip_word("Vertices") && line.skip_spaces() && line.read_number(size) && line.at_end();
+    }
+
+    /**
+     * Parse a chunk of edge list lines.
+     */
+    auto parse_chunk(const char * begin, const char * end, int size, const GraphOptions & options, ParsedEdges & chunk) -> void
+    {
+        Tokeniser text{ begin, end };
+        while (! text.at_end()) {
+            auto line = text.next_line();
+            if (line.at_end())
+                continue;
+
+            line.skip_trailing_char('\r');
+            auto whole_line = line;
+
+            int f, t;
+            line.skip_spaces();
+            if (! line.read_signed_number(f)) {
+                chunk.error = "cannot parse edge line '" + whole_line.rest() + "'";
+                return;
+            }
+            --f;
+
+            if (f < 0 || f >= size) {
+                chunk.error = "invalid f value";
+                return;
+            }
+
+            while (true) {
+                line.skip_spaces();
+                if (line.at_end())
+                    break;
+
+                if (! line.read_signed_number(t)) {
+                    chunk.error = "cannot parse edge line '" + whole_line.rest() + "'";
+                    return;
+                }
+
+                --t;
+                if (t < 0 || t >= size) {
+                    chunk.error = "invalid t value " + std::to_string(t) + " (" + std::to_string(f) + ", " + std::to_string(size) + ")";
+                    return;
+                }
+
+                if (f == t && ! test(options, GraphOptions::AllowLoops)) {
+                    chunk.error = "loop on vertex " + std::to_string(f);
+                    return;
+                }
+
+                chunk.edges.emplace_back(f, t);
+            }
+        }
+    }
+}
+
+auto parasols::read_net(InputFile & input, const GraphOptions & options) -> Graph
 {
     Graph result(0, true);
 
-    std::ifstream infile{ filename };
-    if (! infile)
-        throw GraphFileError{ filename, "unable to open file" };
+    const std::string & filename = input.filename();
+    Tokeniser text{ input.begin(), input.end() };
 
-    std::string line;
-    while (std::getline(infile, line)) {
-        if (line.empty())
+    while (input.refill(text)) {
+        auto line = text.next_line();
+        if (line.at_end())
             continue;
 
-        if (line.at(line.length() - 1) == '\r')
-            line.erase(line.length() - 1);
-
-        static const boost::regex
-            comment{ R"((%.*)?)" },
-            problem{ R"(\*\s*Vertices\s+(\d+))" },
-            description{ R"(\d+\s+".*")" },
-            arcs{ R"(\*\s*Arcslist)" },
-            edge_start{ R"(\*\s*Edgeslist)" };
+        line.skip_trailing_char('\r');
 
-        boost::smatch match;
-        if (regex_match(line, match, comment)) {
+        int size;
+        if (line.at_end() || '%' == line.peek()) {
+            /* comment */
         }
-        else if (regex_match(line, match, description) || regex_match(line, match, arcs)) {
+        else if (description_line(line) || star_line(line, "Arcslist")) {
         }
-        else if (regex_match(line, match, problem)) {
+        else if (problem_line(line, size)) {
             if (0 != result.size())
                 throw GraphFileError{ filename, "multiple '*Vertices' lines encountered" };
-            result.resize(std::stoi(match.str(1)));
+            result.resize(size);
         }
-        else if (regex_match(line, match, edge_start)) {
+        else if (star_line(line, "Edgeslist")) {
             break;
         }
         else
-            throw GraphFileError{ filename, "cannot parse line '" + line + "'" };
+            throw GraphFileError{ filename, "cannot parse line '" + line.rest() + "'" };
     }
 
-    while (std::getline(infile, line)) {
-        if (line.empty())
-            continue;
-
-        if (line.at(line.length() - 1) == '\r')
-            line.erase(line.length() - 1);
-
-        std::stringstream line_s{ line };
-        int f, t;
-
-        if (! (line_s >> f))
-            throw GraphFileError{ filename, "cannot parse edge line '" + line + "'" };
-        --f;
+    input.for_each_remaining_block(text, [&] (const char * begin, const char * end) {
+            auto chunks = parse_chunks<ParsedEdges>(begin, end,
+                    [&] (const char * chunk_begin, const char * chunk_end, ParsedEdges & chunk) {
+                        parse_chunk(chunk_begin, chunk_end, result.size(), options, chunk);
+                    });
 
-        if (f < 0 || f >= result.size())
-            throw GraphFileError{ filename, "invalid f value" };
+            /* Report the first problem in the block, if there is one. */
+            for (auto & chunk : chunks)
+                if (! chunk.error.empty())
+                    throw GraphFileError{ filename, chunk.error };
 
-        while (line_s >> t) {
-            --t;
-            if (t < 0 || t >= result.size())
-                throw GraphFileError{ filename, "invalid t value " + std::to_string(t) + " (" + std::to_string(f) + ", " + std::to_string(result.size()) + ")" };
-
-            if (f == t && ! test(options, GraphOptions::AllowLoops))
-                throw GraphFileError{ filename, "loop on vertex " + std::to_string(f) };
-
-            result.add_edge(f, t);
-        }
-
-        if (! line_s.eof())
-            throw GraphFileError{ filename, "cannot parse edge line '" + line + "'" };
-    }
-
-    if (! infile.eof())
-        throw GraphFileError{ filename, "error reading file" };
+            for (auto & chunk : chunks)
+                for (auto & edge : chunk.edges)
+                    result.add_edge(edge.first, edge.second);
+        });
 
     return result;
 }
 
+auto parasols::read_net(const std::string & filename, const GraphOptions & options) -> Graph
+{
+    InputFile input{ filename };
+    return read_net(input, options);
+}
@@ -4,6 +4,7 @@
 #define PARASOLS_GUARD_GRAPH_NET_HH 1
 
 #include <graph/graph.hh>
+#include <graph/input_file.hh>
 #include <string>
 
 namespace parasols
@@ -14,6 +15,14 @@ namespace parasols
      * \throw GraphFileError
      */
     auto read_net(const std::string & filename, const GraphOptions &) -> Graph;
+
+    /**
+     * Read a net format file from an InputFile which has not yet been
+     * used.
+     *
+     * \throw GraphFileError
+     */
+    auto read_net(InputFile & input, const GraphOptions &) -> Graph;
 }
 
 #endif
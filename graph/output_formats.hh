@@ -0,0 +1,31 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_OUTPUT_FORMATS_HH
+#define PARASOLS_GUARD_GRAPH_OUTPUT_FORMATS_HH 1
+
+#include <graph/graph_writer.hh>
+
+#include <utility>
+#include <functional>
+
+namespace parasols
+{
+    namespace detail
+    {
+        using GraphWriterFunction = std::function<void (std::ostream &, const Graph &)>;
+
+        using namespace std::placeholders;
+
+        auto graph_writers = {
+            std::make_pair( std::string{ "dimacs" },  GraphWriterFunction{ std::bind(write_dimacs, _1, _2, 0) } ),
+            std::make_pair( std::string{ "pairs0" },  GraphWriterFunction{ std::bind(write_pairs, _1, _2, false, 0) } ),
+            std::make_pair( std::string{ "pairs1" },  GraphWriterFunction{ std::bind(write_pairs, _1, _2, true, 0) } ),
+            std::make_pair( std::string{ "lad" },     GraphWriterFunction{ std::bind(write_lad, _1, _2, 0) } ),
+            std::make_pair( std::string{ "binary" },  GraphWriterFunction{ std::bind(write_unpermuted_binary, _1, _2) } )
+        };
+    }
+
+    using detail::graph_writers;
+}
+
+#endif
@@ -3,65 +3,138 @@
 #include <graph/pairs.hh>
 #include <graph/graph.hh>
 #include <graph/graph_file_error.hh>
-#include <boost/regex.hpp>
-#include <fstream>
+#include <graph/input_file.hh>
+#include <graph/tokeniser.hh>
 
 using namespace parasols;
 
-auto parasols::read_pairs(const std::string & filename, bool one_indexed, const GraphOptions & options) -> Graph
+namespace
 {
-    std::ifstream infile{ filename };
-    if (! infile)
-        throw GraphFileError{ filename, "unable to open file" };
-
-    std::string line;
-
-    static const boost::regex double_header{ R"((\d+)\s+(\d+)\s*(\d+)?)" };
-    unsigned size;
+    /**
+     * Is this line a (\d+)\s+(\d+)\s*(\d+)? header?
+     */
+    auto double_header(Tokeniser line, int & size) -> bool
+    {
+        int n;
+        if (! (line.read_number(size) && line.skip_spaces() && line.read_number(n)))
+            return false;
 
-    if (! std::getline(infile, line))
-        throw GraphFileError{ filename, "cannot parse number of vertices" };
+        line.skip_spaces();
+        line.read_number(n);
+        return line.at_end();
+    }
 
+    /**
+     * Parse a single number header, the way std::stoi does.
+     */
+    auto single_header(Tokeniser line, int & size) -> bool
     {
-        boost::smatch match;
-        if (regex_match(line, match, double_header))
-            size = std::stoi(match.str(1));
-        else {
-            size = std::stoi(line);
-            std::getline(infile, line);
-        }
+        line.skip_whitespace();
+        return line.read_signed_number(size);
     }
 
-    Graph result(size, one_indexed);
-
-    while (std::getline(infile, line)) {
-        if (line.empty())
-            continue;
-
-        static const boost::regex edge{ R"((\d+)(,|\s+)(\d+)\s*)" };
-        boost::smatch match;
-
-        if (regex_match(line, match, edge)) {
-            int a{ std::stoi(match.str(1)) }, b{ std::stoi(match.str(3)) };
+    /**
+     * Parse a chunk of (\d+)(,|\s+)(\d+)\s* lines.
+     */
+    auto parse_chunk(const char * begin, const char * end, int size, bool one_indexed, const GraphOptions & options,
+            ParsedEdges & chunk) -> void
+    {
+        Tokeniser text{ begin, end };
+        while (! text.at_end()) {
+            auto line = text.next_line();
+            if (line.at_end())
+                continue;
+
+            auto whole_line = line;
+
+            int a, b;
+            if (! (line.read_number(a)
+                        && (line.skip_char(',') || line.skip_spaces())
+                        && line.read_number(b)
+                        && (line.skip_spaces(), line.at_end()))) {
+                chunk.error = "cannot parse line '" + whole_line.rest() + "'";
+                return;
+            }
 
             if (one_indexed) {
                 --a;
                 --b;
             }
 
-            if (a >= result.size() || b >= result.size() || a < 0 || b < 0)
-                throw GraphFileError{ filename, "line '" + line + "' edge index out of bounds" };
-            else if (a == b && ! test(options, GraphOptions::AllowLoops))
-                throw GraphFileError{ filename, "line '" + line + "' contains a loop on vertex " + std::to_string(a) };
-            result.add_edge(a, b);
+            if (a >= size || b >= size || a < 0 || b < 0) {
+                chunk.error = "line '" + whole_line.rest() + "' edge index out of bounds";
+                return;
+            }
+            else if (a == b && ! test(options, GraphOptions::AllowLoops)) {
+                chunk.error = "line '" + whole_line.rest() + "' contains a loop on vertex " + std::to_string(a);
+                return;
+            }
+
+            chunk.edges.emplace_back(a, b);
         }
-        else
-            throw GraphFileError{ filename, "cannot parse line '" + line + "'" };
     }
 
-    if (! infile.eof())
-        throw GraphFileError{ filename, "error reading file" };
+    /**
+     * Parse a pairs file, passing the size and then each edge to the
+     * supplied callbacks.
+     */
+    template <typename SetSize_, typename AddEdge_>
+    auto read_pairs_edges(InputFile & input, bool one_indexed, const GraphOptions & options,
+            const SetSize_ & set_size, const AddEdge_ & add_edge) -> void
+    {
+        const std::string & filename = input.filename();
+        Tokeniser text{ input.begin(), input.end() };
+
+        if (! input.refill(text))
+            throw GraphFileError{ filename, "cannot parse number of vertices" };
+
+        int size;
+        auto first_line = text.next_line();
+        if (! double_header(first_line, size)) {
+            if (! single_header(first_line, size))
+                throw GraphFileError{ filename, "cannot parse number of vertices" };
+            if (input.refill(text))
+                text.next_line();
+        }
+
+        set_size(size);
+
+        input.for_each_remaining_block(text, [&] (const char * begin, const char * end) {
+                auto chunks = parse_chunks<ParsedEdges>(begin, end,
+                        [&] (const char * chunk_begin, const char * chunk_end, ParsedEdges & chunk) {
+                            parse_chunk(chunk_begin, chunk_end, size, one_indexed, options, chunk);
+                        });
+
+                /* Report the first problem in the block, if there is one. */
+                for (auto & chunk : chunks)
+                    if (! chunk.error.empty())
+                        throw GraphFileError{ filename, chunk.error };
+
+                for (auto & chunk : chunks) {
+                    for (auto & edge : chunk.edges)
+                        add_edge(edge.first, edge.second);
+
+                    chunk.edges = decltype(chunk.edges)();
+                }
+            });
+    }
+}
+
+auto parasols::read_pairs(const std::string & filename, bool one_indexed, const GraphOptions & options) -> Graph
+{
+    Graph result(0, one_indexed);
+
+    InputFile input{ filename };
+    read_pairs_edges(input, one_indexed, options,
+            [&] (int size) { result.resize(size); },
+            [&] (int a, int b) { result.add_edge(a, b); });
 
     return result;
 }
 
+auto parasols::read_sparse_pairs(const std::string & filename, bool one_indexed, const GraphOptions & options) -> SparseGraph
+{
+    return read_sparse_graph(filename, one_indexed, [&] (InputFile & input, const auto & set_size, const auto & add_edge) {
+            read_pairs_edges(input, one_indexed, options, set_size, add_edge);
+            });
+}
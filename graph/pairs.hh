@@ -4,6 +4,7 @@
 #define PARASOLS_GUARD_GRAPH_PAIRS_HH 1
 
 #include <graph/graph.hh>
+#include <graph/sparse_graph.hh>
 #include <string>
 
 namespace parasols
@@ -18,6 +19,13 @@ namespace parasols
      * \throw GraphFileError
      */
     auto read_pairs(const std::string & filename, bool one_indexed, const GraphOptions &) -> Graph;
+
+    /**
+     * Read a (v,v) or (v v) format file into a SparseGraph.
+     *
+     * \throw GraphFileError
+     */
+    auto read_sparse_pairs(const std::string & filename, bool one_indexed, const GraphOptions &) -> SparseGraph;
 }
 
 #endif
@@ -0,0 +1,73 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/permute_graph.hh>
+
+#include <algorithm>
+#include <thread>
+
+using namespace parasols;
+
+namespace
+{
+    /// Below this many rows, threads cost more than they save.
+    constexpr int rows_per_thread = 1024;
+}
+
+auto parasols::inverse_order(const Graph & graph, const std::vector<int> & order) -> std::vector<int>
+{
+    std::vector<int> position(graph.size(), -1);
+    for (unsigned i = 0 ; i < order.size() ; ++i)
+        position[order[i]] = i;
+    return position;
+}
+
+auto parasols::is_identity_order(const Graph & graph, const std::vector<int> & order) -> bool
+{
+    if (order.size() != unsigned(graph.size()))
+        return false;
+
+    for (unsigned i = 0 ; i < order.size() ; ++i)
+        if (order[i] != int(i))
+            return false;
+
+    return true;
+}
+
+auto parasols::encode_permuted_row(const Graph & graph, int v, const std::vector<int> & position,
+        BitWord * words, int n_words) -> void
+{
+    std::fill(words, words + n_words, 0);
+
+    const BitWord * row = graph.neighbourhood_words(v);
+    for (int w = 0 ; w < graph.words_per_row() ; ++w) {
+        BitWord bits = row[w];
+        while (0 != bits) {
+            int b = __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            int p = position[w * bits_per_word + b];
+            if (-1 != p)
+                words[p / bits_per_word] |= (BitWord{ 1 } << (p % bits_per_word));
+        }
+    }
+}
+
+auto parasols::for_each_row_range(int n_rows, const std::function<void (int, int)> & f) -> void
+{
+    unsigned n_threads = std::min<unsigned>(std::max(1u, std::thread::hardware_concurrency()),
+            n_rows / rows_per_thread);
+
+    if (n_threads <= 1) {
+        f(0, n_rows);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0 ; t < n_threads ; ++t) {
+        int begin = (long long)(n_rows) * t / n_threads, end = (long long)(n_rows) * (t + 1) / n_threads;
+        threads.emplace_back([&f, begin, end] { f(begin, end); });
+    }
+
+    for (auto & t : threads)
+        t.join();
+}
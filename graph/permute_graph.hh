@@ -0,0 +1,74 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_PERMUTE_GRAPH_HH
+#define PARASOLS_GUARD_GRAPH_PERMUTE_GRAPH_HH 1
+
+#include <graph/graph.hh>
+#include <graph/bit_graph.hh>
+
+#include <vector>
+#include <functional>
+
+namespace parasols
+{
+    /**
+     * Return the position of each vertex of graph in order, or -1 if it does
+     * not appear.
+     */
+    auto inverse_order(const Graph & graph, const std::vector<int> & order) -> std::vector<int>;
+
+    /**
+     * Does order contain every vertex of graph, in its original position?
+     */
+    auto is_identity_order(const Graph & graph, const std::vector<int> & order) -> bool;
+
+    /**
+     * Write the neighbourhood of v, renumbered using position (from
+     * inverse_order), into n_words words. Neighbours which do not appear in
+     * the order are dropped.
+     */
+    auto encode_permuted_row(const Graph & graph, int v, const std::vector<int> & position,
+            BitWord * words, int n_words) -> void;
+
+    /**
+     * Split the rows [0, n_rows) into ranges, and call f(begin, end) for
+     * each range, in parallel if there are enough rows to make it
+     * worthwhile.
+     */
+    auto for_each_row_range(int n_rows, const std::function<void (int, int)> & f) -> void;
+
+    /**
+     * Re-encode the subgraph of graph induced by order as a bit graph, so
+     * that vertex i of the result is vertex order[i] of graph.
+     *
+     * This goes a word at a time rather than doing n^2 adjacency tests:
+     * each row is built by walking the set bits of the original row. If the
+     * order is the identity, the rows are copied across directly.
+     */
+    template <typename BitGraph_>
+    auto permute_graph(const Graph & graph, const std::vector<int> & order, BitGraph_ & result) -> void
+    {
+        result.resize(order.size());
+
+        if (is_identity_order(graph, order)) {
+            for_each_row_range(graph.size(), [&] (int begin, int end) {
+                    for (int i = begin ; i < end ; ++i)
+                        result.set_neighbourhood_words(i, graph.neighbourhood_words(i), graph.words_per_row());
+                    });
+            return;
+        }
+
+        auto position = inverse_order(graph, order);
+        int n_words = (order.size() + bits_per_word - 1) / bits_per_word;
+
+        for_each_row_range(order.size(), [&] (int begin, int end) {
+                std::vector<BitWord> words(n_words);
+                for (int i = begin ; i < end ; ++i) {
+                    encode_permuted_row(graph, order[i], position, words.data(), n_words);
+                    result.set_neighbourhood_words(i, words.data(), n_words);
+                }
+            });
+    }
+}
+
+#endif
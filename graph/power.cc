@@ -2,7 +2,7 @@
 
 #include <graph/power.hh>
 #include <graph/kneighbours.hh>
-#include <limits>
+#include <graph/permute_graph.hh>
 
 using namespace parasols;
 
@@ -11,11 +11,22 @@ Graph parasols::power(const Graph & graph, int n)
     KNeighbours distances(graph, n);
     Graph result((graph));
 
-    for (int i = 0 ; i < graph.size() ; ++i)
-        for (int j = 0 ; j < graph.size() ; ++j)
-            if (i != j && distances.vertices[i].distances[j].distance > 0)
-                result.add_edge(i, j);
+    /* everything within distance n, other than ourselves, unless we
+     * already had a loop */
+    for_each_row_range(graph.size(), [&] (int begin, int end) {
+            std::vector<BitWord> row(graph.words_per_row());
+            for (int i = begin ; i < end ; ++i) {
+                const BitWord * within = distances.within_words(i);
+                const BitWord * original = graph.neighbourhood_words(i);
+                for (int w = 0 ; w < graph.words_per_row() ; ++w)
+                    row[w] = within[w] | original[w];
+
+                if (! graph.adjacent(i, i))
+                    row[i / bits_per_word] &= ~(BitWord{ 1 } << (i % bits_per_word));
+
+                result.set_neighbourhood_words(i, row.data());
+            }
+        });
 
     return result;
 }
-
@@ -1,66 +1,134 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 #include <graph/product.hh>
+#include <graph/permute_graph.hh>
 
-auto parasols::modular_product(const Graph & g1, const Graph & g2) -> Graph
+#include <algorithm>
+
+using namespace parasols;
+
+namespace
 {
-    Graph result(g1.size() * g2.size(), false);
-
-    for (int v1 = 0 ; v1 < g1.size() ; ++v1)
-        for (int v2 = 0 ; v2 < g2.size() ; ++v2)
-            for (int w1 = 0 ; w1 < g1.size() ; ++w1)
-                for (int w2 = 0 ; w2 < g2.size() ; ++w2) {
-                    unsigned p1 = v2 * g1.size() + v1;
-                    unsigned p2 = w2 * g1.size() + w1;
-                    if (p1 != p2 && v1 != w1 && v2 != w2 && (g1.adjacent(v1, w1) == g2.adjacent(v2, w2))) {
-                        result.add_edge(p1, p2);
+    /**
+     * For a vertex v1 of the first graph, its neighbours, its non-neighbours,
+     * and every other vertex, all excluding v1 itself.
+     */
+    struct RowMasks
+    {
+        std::vector<BitWord> adjacent, nonadjacent, others;
+
+        explicit RowMasks(int n_words) :
+            adjacent(n_words),
+            nonadjacent(n_words),
+            others(n_words)
+        {
+        }
+
+        auto build(const Graph & g1, int v1) -> void
+        {
+            const BitWord * row = g1.neighbourhood_words(v1);
+            for (int w = 0 ; w < g1.words_per_row() ; ++w) {
+                others[w] = ~BitWord{ 0 };
+                if (w == g1.words_per_row() - 1 && 0 != g1.size() % bits_per_word)
+                    others[w] = (BitWord{ 1 } << (g1.size() % bits_per_word)) - 1;
+                if (w == v1 / bits_per_word)
+                    others[w] &= ~(BitWord{ 1 } << (v1 % bits_per_word));
+
+                adjacent[w] = row[w] & others[w];
+                nonadjacent[w] = ~row[w] & others[w];
+            }
+        }
+    };
+
+    /**
+     * Or the first n_bits bits of bits into row, starting at bit offset.
+     * Any bits of bits past n_bits must be zero.
+     */
+    auto or_bits_at(BitWord * row, std::size_t offset, const BitWord * bits, int n_bits) -> void
+    {
+        std::size_t first = offset / bits_per_word;
+        unsigned shift = offset % bits_per_word;
+        int n_words = (n_bits + bits_per_word - 1) / bits_per_word;
+
+        for (int w = 0 ; w < n_words ; ++w) {
+            row[first + w] |= bits[w] << shift;
+            if (0 != shift && 0 != (bits[w] >> (bits_per_word - shift)))
+                row[first + w + 1] |= bits[w] >> (bits_per_word - shift);
+        }
+    }
+
+    /**
+     * Build a product graph, whose vertex v2 * g1.size() + v1 corresponds to
+     * the pair (v1, v2). Rows are built a block at a time: for each w2 other
+     * than v2, choose(v1, v2, w2, masks, scratch) gives the set of w1 to
+     * join to (or nullptr for none), typically one of the masks for v1.
+     */
+    template <typename Choose_>
+    auto build_product(const Graph & g1, const Graph & g2, const Choose_ & choose) -> Graph
+    {
+        Graph result(g1.size() * g2.size(), false);
+        int n1 = g1.size(), n2 = g2.size();
+
+        for_each_row_range(n1 * n2, [&] (int begin, int end) {
+                std::vector<BitWord> row(result.words_per_row()), scratch(g1.words_per_row());
+                RowMasks masks(g1.words_per_row());
+
+                for (int p1 = begin ; p1 < end ; ++p1) {
+                    int v1 = p1 % n1, v2 = p1 / n1;
+                    masks.build(g1, v1);
+
+                    std::fill(row.begin(), row.end(), 0);
+                    for (int w2 = 0 ; w2 < n2 ; ++w2) {
+                        if (w2 == v2)
+                            continue;
+
+                        const BitWord * bits = choose(v1, v2, w2, masks, scratch.data());
+                        if (bits)
+                            or_bits_at(row.data(), std::size_t(w2) * n1, bits, n1);
                     }
+
+                    result.set_neighbourhood_words(p1, row.data());
                 }
-    return result;
+            });
+
+        return result;
+    }
+}
+
+auto parasols::modular_product(const Graph & g1, const Graph & g2) -> Graph
+{
+    return build_product(g1, g2, [&] (int, int v2, int w2, const RowMasks & masks, BitWord *) -> const BitWord * {
+            return g2.adjacent(v2, w2) ? masks.adjacent.data() : masks.nonadjacent.data();
+            });
 }
 
 auto parasols::noninduced_modular_product(const Graph & g1, const Graph & g2) -> Graph
 {
-    Graph result(g1.size() * g2.size(), false);
-
-    for (int v1 = 0 ; v1 < g1.size() ; ++v1)
-        for (int v2 = 0 ; v2 < g2.size() ; ++v2)
-            for (int w1 = 0 ; w1 < g1.size() ; ++w1)
-                for (int w2 = 0 ; w2 < g2.size() ; ++w2) {
-                    unsigned p1 = v2 * g1.size() + v1;
-                    unsigned p2 = w2 * g1.size() + w1;
-                    if (p1 != p2 && v1 != w1 && v2 != w2 && ((! g1.adjacent(v1, w1)) || g2.adjacent(v2, w2))) {
-                        result.add_edge(p1, p2);
-                    }
-                }
-    return result;
+    return build_product(g1, g2, [&] (int, int v2, int w2, const RowMasks & masks, BitWord *) -> const BitWord * {
+            return g2.adjacent(v2, w2) ? masks.others.data() : masks.nonadjacent.data();
+            });
 }
 
 auto parasols::subgraph_modular_product(const Graph & g1, const Graph & g2) -> Graph
 {
-    Graph result(g1.size() * g2.size(), false);
-
-    std::vector<int> degrees1((g1.size())), degrees2((g2.size()));
-
-    for (int i = 0 ; i < g1.size() ; ++i)
-        degrees1[i] = g1.degree(i);
+    // for each vertex w2, the vertices of g1 with degree no higher
+    int n_words = g1.words_per_row();
+    std::vector<BitWord> fits(std::size_t(g2.size()) * n_words, 0);
+    for (int w2 = 0 ; w2 < g2.size() ; ++w2)
+        for (int w1 = 0 ; w1 < g1.size() ; ++w1)
+            if (g1.degree(w1) <= g2.degree(w2))
+                fits[std::size_t(w2) * n_words + w1 / bits_per_word] |= (BitWord{ 1 } << (w1 % bits_per_word));
 
-    for (int i = 0 ; i < g2.size() ; ++i)
-        degrees2[i] = g2.degree(i);
-
-    for (int v1 = 0 ; v1 < g1.size() ; ++v1)
-        for (int v2 = 0 ; v2 < g2.size() ; ++v2)
-            for (int w1 = 0 ; w1 < g1.size() ; ++w1)
-                for (int w2 = 0 ; w2 < g2.size() ; ++w2) {
-                    unsigned p1 = v2 * g1.size() + v1;
-                    unsigned p2 = w2 * g1.size() + w1;
-                    if (p1 != p2 && v1 != w1 && v2 != w2 && (g1.adjacent(v1, w1) == g2.adjacent(v2, w2))) {
-                        if (degrees1[v1] <= degrees2[v2] && degrees1[w1] <= degrees2[w2])
-                            result.add_edge(p1, p2);
-                    }
-                }
+    return build_product(g1, g2, [&] (int v1, int v2, int w2, const RowMasks & masks, BitWord * scratch) -> const BitWord * {
+            if (g1.degree(v1) > g2.degree(v2))
+                return nullptr;
 
-    return result;
+            const BitWord * bits = g2.adjacent(v2, w2) ? masks.adjacent.data() : masks.nonadjacent.data();
+            const BitWord * fit = &fits[std::size_t(w2) * n_words];
+            for (int w = 0 ; w < n_words ; ++w)
+                scratch[w] = bits[w] & fit[w];
+            return scratch;
+            });
 }
 
 auto parasols::unproduct(const Graph & g1, const Graph &, int v) -> std::pair<int, int>
@@ -0,0 +1,138 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/random_graph.hh>
+#include <graph/permute_graph.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace parasols;
+
+namespace
+{
+    /* Below this, skipping from edge to edge is cheaper than building whole
+     * words of edges. */
+    const constexpr double skip_threshold = 0.125;
+
+    /* How many binary places of p we use when building words of edges. */
+    const constexpr int p_places = 32;
+
+    /**
+     * Set each bit in [from, to) of row with probability p.
+     */
+    auto random_row(RandomStream & stream, double p, int from, int to, BitWord * row) -> void
+    {
+        if (from >= to || p <= 0.0)
+            return;
+
+        if (p >= 1.0) {
+            for (int w = from ; w < to ; ++w)
+                row[w / bits_per_word] |= (BitWord{ 1 } << (w % bits_per_word));
+        }
+        else if (p < skip_threshold) {
+            /* The gap before the next edge is geometrically distributed. */
+            double log_q = std::log1p(-p);
+            for (int w = from ; ; ++w) {
+                double skip = std::floor(std::log(1.0 - stream.uniform()) / log_q);
+                if (skip >= to - w)
+                    break;
+
+                w += int(skip);
+                row[w / bits_per_word] |= (BitWord{ 1 } << (w % bits_per_word));
+            }
+        }
+        else {
+            /* Going from the least significant place of p upwards, a set
+             * place ors in a random word, and a clear place ands one in.
+             * Each bit ends up set with probability p, to p_places places. */
+            std::uint64_t places = std::uint64_t(p * double(std::uint64_t{ 1 } << p_places));
+            if (0 == places)
+                return;
+            int lowest = __builtin_ctzll(places);
+
+            for (int w = from / bits_per_word ; w <= (to - 1) / bits_per_word ; ++w) {
+                BitWord mask = 0;
+                for (int i = lowest ; i < p_places ; ++i) {
+                    if ((places >> i) & 1)
+                        mask |= stream.next();
+                    else
+                        mask &= stream.next();
+                }
+
+                if (w == from / bits_per_word)
+                    mask &= ~BitWord{ 0 } << (from % bits_per_word);
+                if (w == (to - 1) / bits_per_word && 0 != to % bits_per_word)
+                    mask &= ~(~BitWord{ 0 } << (to % bits_per_word));
+
+                row[w] |= mask;
+            }
+        }
+    }
+
+    /**
+     * Build a graph from the upper triangle given by random rows, where row
+     * v has edges in range(v), which must be above the diagonal.
+     */
+    template <typename Range_>
+    auto build_graph(int size, double p, std::uint64_t seed, bool add_one_for_output, const Range_ & range) -> Graph
+    {
+        Graph result(size, add_one_for_output);
+        int words_per_row = result.words_per_row();
+
+        std::vector<BitWord> upper(std::vector<BitWord>::size_type(size) * words_per_row, 0);
+        for_each_row_range(size, [&] (int begin, int end) {
+                for (int v = begin ; v < end ; ++v) {
+                    RandomStream stream{ seed, std::uint64_t(v) };
+                    auto r = range(v);
+                    random_row(stream, p, r.first, r.second, &upper[std::vector<BitWord>::size_type(v) * words_per_row]);
+                }
+            });
+
+        /* Each row is its upper part, plus its column of the upper triangle,
+         * which we collect by walking the part of each earlier row that lies
+         * in this range of columns. */
+        for_each_row_range(size, [&] (int begin, int end) {
+                std::vector<BitWord> rows(upper.begin() + std::vector<BitWord>::size_type(begin) * words_per_row,
+                        upper.begin() + std::vector<BitWord>::size_type(end) * words_per_row);
+
+                for (int v = 0 ; v < end - 1 ; ++v) {
+                    const BitWord * row = &upper[std::vector<BitWord>::size_type(v) * words_per_row];
+                    int first = std::max(begin, v + 1);
+                    for (int w = first / bits_per_word ; w <= (end - 1) / bits_per_word ; ++w) {
+                        BitWord bits = row[w];
+                        if (w == first / bits_per_word)
+                            bits &= ~BitWord{ 0 } << (first % bits_per_word);
+                        if (w == (end - 1) / bits_per_word && 0 != end % bits_per_word)
+                            bits &= ~(~BitWord{ 0 } << (end % bits_per_word));
+
+                        while (0 != bits) {
+                            int u = w * bits_per_word + __builtin_ctzll(bits);
+                            bits &= bits - 1;
+                            rows[std::vector<BitWord>::size_type(u - begin) * words_per_row + v / bits_per_word] |=
+                                (BitWord{ 1 } << (v % bits_per_word));
+                        }
+                    }
+                }
+
+                for (int v = begin ; v < end ; ++v)
+                    result.set_neighbourhood_words(v, &rows[std::vector<BitWord>::size_type(v - begin) * words_per_row]);
+            });
+
+        return result;
+    }
+}
+
+auto parasols::random_graph(int size, double p, std::uint64_t seed, bool add_one_for_output) -> Graph
+{
+    return build_graph(size, p, seed, add_one_for_output, [&] (int v) {
+            return std::make_pair(v + 1, size);
+            });
+}
+
+auto parasols::random_bipartite_graph(int size1, int size2, double p, std::uint64_t seed, bool add_one_for_output) -> Graph
+{
+    return build_graph(size1 + size2, p, seed, add_one_for_output, [&] (int v) {
+            return v < size1 ? std::make_pair(size1, size1 + size2) : std::make_pair(0, 0);
+            });
+}
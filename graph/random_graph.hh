@@ -0,0 +1,71 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_RANDOM_GRAPH_HH
+#define PARASOLS_GUARD_GRAPH_RANDOM_GRAPH_HH 1
+
+#include <graph/graph.hh>
+
+#include <cstdint>
+
+namespace parasols
+{
+    /**
+     * A counter-based stream of random numbers. The i'th number of a stream
+     * is a hash of the stream's key and i, and the key is a hash of a seed
+     * and a stream number, so any number of independent streams can be
+     * split off one seed and used in any order.
+     */
+    class RandomStream
+    {
+        private:
+            std::uint64_t _key, _counter;
+
+            static auto _mix(std::uint64_t z) -> std::uint64_t
+            {
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                return z ^ (z >> 31);
+            }
+
+        public:
+            RandomStream(std::uint64_t seed, std::uint64_t stream) :
+                _key(_mix(_mix(seed + 0x9e3779b97f4a7c15ull) ^ (stream * 0xd1b54a32d192ed03ull))),
+                _counter(0)
+            {
+            }
+
+            auto next() -> std::uint64_t
+            {
+                return _mix(_key + 0x9e3779b97f4a7c15ull * ++_counter);
+            }
+
+            /**
+             * A number uniformly distributed in [0, 1).
+             */
+            auto uniform() -> double
+            {
+                return (next() >> 11) * (1.0 / 9007199254740992.0);
+            }
+    };
+
+    /**
+     * A G(n, p) random graph, where each edge is present with probability
+     * p. The same size, p and seed always give the same graph.
+     *
+     * Each row has its own RandomStream, so rows are generated in parallel,
+     * straight into packed words. For sparse graphs we jump from edge to edge
+     * by drawing geometrically distributed gaps. Otherwise we build a whole
+     * word of edges at a time, by combining random words according to the
+     * binary expansion of p, which is accurate to 2^-32.
+     */
+    auto random_graph(int size, double p, std::uint64_t seed, bool add_one_for_output) -> Graph;
+
+    /**
+     * A random bipartite graph, with each edge between the first size1 and
+     * the last size2 vertices present with probability p, generated as
+     * above.
+     */
+    auto random_bipartite_graph(int size1, int size2, double p, std::uint64_t seed, bool add_one_for_output) -> Graph;
+}
+
+#endif
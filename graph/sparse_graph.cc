@@ -0,0 +1,155 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/sparse_graph.hh>
+#include <algorithm>
+
+using namespace parasols;
+
+SparseGraph::SparseGraph(int size, bool add_one_for_output) :
+    _add_one_for_output(add_one_for_output)
+{
+    if (0 != size)
+        resize(size);
+}
+
+auto SparseGraph::size() const -> int
+{
+    return _size;
+}
+
+auto SparseGraph::resize(int size) -> void
+{
+    _size = size;
+    _offsets.assign(size + 1, 0);
+}
+
+auto SparseGraph::count_edge(int a, int b) -> void
+{
+    ++_offsets[a + 1];
+    if (a != b)
+        ++_offsets[b + 1];
+}
+
+auto SparseGraph::start_filling() -> void
+{
+    for (int v = 0 ; v < _size ; ++v)
+        _offsets[v + 1] += _offsets[v];
+
+    _neighbours.resize(_offsets[_size]);
+    _fill.assign(_offsets.begin(), _offsets.end() - 1);
+}
+
+auto SparseGraph::add_edge(int a, int b) -> bool
+{
+    if (_fill[a] == _offsets[a + 1] || (a != b && _fill[b] == _offsets[b + 1]))
+        return false;
+
+    _neighbours[_fill[a]++] = b;
+    if (a != b)
+        _neighbours[_fill[b]++] = a;
+
+    return true;
+}
+
+auto SparseGraph::finish() -> bool
+{
+    bool complete = true;
+
+    /* Sort each row, and squash out duplicates and any slots that were
+     * counted but never filled, moving rows down as we go. */
+    std::size_t write = 0;
+    for (int v = 0 ; v < _size ; ++v) {
+        if (_fill[v] != _offsets[v + 1])
+            complete = false;
+
+        auto row_begin = _neighbours.begin() + _offsets[v], row_end = _neighbours.begin() + _fill[v];
+        std::sort(row_begin, row_end);
+        row_end = std::unique(row_begin, row_end);
+
+        _offsets[v] = write;
+        write = std::copy(row_begin, row_end, _neighbours.begin() + write) - _neighbours.begin();
+    }
+
+    _offsets[_size] = write;
+    _neighbours.resize(write);
+    _neighbours.shrink_to_fit();
+    _fill.clear();
+    _fill.shrink_to_fit();
+
+    return complete;
+}
+
+auto SparseGraph::adjacent(int a, int b) const -> bool
+{
+    return std::binary_search(_neighbours.begin() + _offsets[a], _neighbours.begin() + _offsets[a + 1], b);
+}
+
+auto SparseGraph::degree(int a) const -> int
+{
+    return _offsets[a + 1] - _offsets[a];
+}
+
+auto SparseGraph::neighbours(int a) const -> Neighbours
+{
+    return Neighbours{ _neighbours.data() + _offsets[a], _neighbours.data() + _offsets[a + 1] };
+}
+
+auto SparseGraph::number_of_edges() const -> std::size_t
+{
+    std::size_t loops = 0;
+    for (int v = 0 ; v < _size ; ++v)
+        if (adjacent(v, v))
+            ++loops;
+
+    return (_neighbours.size() + loops) / 2;
+}
+
+auto SparseGraph::induced_subgraph(const std::vector<int> & vertices) const -> SparseGraph
+{
+    std::vector<int> position(_size, -1);
+    for (unsigned i = 0 ; i < vertices.size() ; ++i)
+        position[vertices[i]] = i;
+
+    SparseGraph result(vertices.size(), _add_one_for_output);
+
+    /* Each edge is seen from both ends, so only take it from the lower
+     * numbered end in the new graph. */
+    for (unsigned i = 0 ; i < vertices.size() ; ++i)
+        for (auto & w : neighbours(vertices[i]))
+            if (-1 != position[w] && unsigned(position[w]) >= i)
+                result.count_edge(i, position[w]);
+
+    result.start_filling();
+
+    for (unsigned i = 0 ; i < vertices.size() ; ++i)
+        for (auto & w : neighbours(vertices[i]))
+            if (-1 != position[w] && unsigned(position[w]) >= i)
+                result.add_edge(i, position[w]);
+
+    result.finish();
+
+    return result;
+}
+
+auto SparseGraph::induced_graph(const std::vector<int> & vertices) const -> Graph
+{
+    std::vector<int> position(_size, -1);
+    for (unsigned i = 0 ; i < vertices.size() ; ++i)
+        position[vertices[i]] = i;
+
+    Graph result(vertices.size(), _add_one_for_output);
+    for (unsigned i = 0 ; i < vertices.size() ; ++i)
+        for (auto & w : neighbours(vertices[i]))
+            if (-1 != position[w])
+                result.add_edge(i, position[w]);
+
+    return result;
+}
+
+auto SparseGraph::vertex_name(int a) const -> std::string
+{
+    if (_add_one_for_output)
+        return std::to_string(a + 1);
+    else
+        return std::to_string(a);
+}
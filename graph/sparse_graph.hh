@@ -0,0 +1,237 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_SPARSE_GRAPH_HH
+#define PARASOLS_GUARD_GRAPH_SPARSE_GRAPH_HH 1
+
+#include <graph/graph.hh>
+#include <graph/bit_graph.hh>
+#include <graph/graph_file_error.hh>
+#include <graph/input_file.hh>
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstddef>
+
+namespace parasols
+{
+    /**
+     * A graph, with a compressed sparse row representation. Memory use scales
+     * with the number of edges rather than with the square of the number of
+     * vertices, so this is what we use for inputs that are too big to load
+     * into a Graph.
+     *
+     * A SparseGraph is built in two passes over the edges. First every edge
+     * is given to count_edge(), then start_filling() is called, then every
+     * edge is given again to add_edge(), and finally finish() is called.
+     * Duplicate edges are allowed, and are removed by finish(). Only the
+     * query operations may be used after finish().
+     *
+     * Indices start at 0.
+     */
+    class SparseGraph
+    {
+        public:
+            /**
+             * A range over the neighbours of a vertex, in increasing order.
+             */
+            class Neighbours
+            {
+                private:
+                    const int * _begin, * _end;
+
+                public:
+                    Neighbours(const int * b, const int * e) :
+                        _begin(b),
+                        _end(e)
+                    {
+                    }
+
+                    auto begin() const -> const int *
+                    {
+                        return _begin;
+                    }
+
+                    auto end() const -> const int *
+                    {
+                        return _end;
+                    }
+            };
+
+        private:
+            int _size = 0;
+            std::vector<std::size_t> _offsets;
+            std::vector<std::size_t> _fill;
+            std::vector<int> _neighbours;
+            bool _add_one_for_output = false;
+
+        public:
+            /**
+             * \param initial_size can be 0, if resize() is called afterwards.
+             *
+             * \param add_one_for_output is true if the graph should be
+             * displayed 1-indexed (this affects vertex_name, but vertex
+             * numbers are still 0-indexed).
+             */
+            SparseGraph(int initial_size, bool add_one_for_output);
+
+            explicit SparseGraph() = default;
+
+            /**
+             * Number of vertices.
+             */
+            auto size() const -> int;
+
+            /**
+             * Change our size. Must be called before counting an edge, and
+             * must not be called afterwards.
+             */
+            auto resize(int size) -> void;
+
+            /**
+             * First pass: note that there is an edge from a to b (and from b
+             * to a).
+             */
+            auto count_edge(int a, int b) -> void;
+
+            /**
+             * Switch from counting edges to adding them.
+             */
+            auto start_filling() -> void;
+
+            /**
+             * Second pass: add an edge from a to b (and from b to a). Returns
+             * false if this edge was not counted in the first pass.
+             */
+            auto add_edge(int a, int b) -> bool;
+
+            /**
+             * Sort neighbourhoods and remove duplicate edges. Returns false if
+             * fewer edges were added than were counted.
+             */
+            auto finish() -> bool;
+
+            /**
+             * Are vertices a and b adjacent?
+             */
+            auto adjacent(int a, int b) const -> bool;
+
+            /**
+             * What is the degree of a given vertex? A loop counts once.
+             */
+            auto degree(int a) const -> int;
+
+            /**
+             * The neighbours of a given vertex.
+             */
+            auto neighbours(int a) const -> Neighbours;
+
+            /**
+             * How many edges do we have? A loop counts once.
+             */
+            auto number_of_edges() const -> std::size_t;
+
+            /**
+             * The subgraph induced by the given vertices. Vertex i of the
+             * result is vertices[i].
+             */
+            auto induced_subgraph(const std::vector<int> & vertices) const -> SparseGraph;
+
+            /**
+             * The subgraph induced by the given vertices, as a Graph. Vertex i
+             * of the result is vertices[i].
+             */
+            auto induced_graph(const std::vector<int> & vertices) const -> Graph;
+
+            /**
+             * Format a vertex for outputting.
+             */
+            auto vertex_name(int a) const -> std::string;
+
+            /**
+             * Add one for output?
+             */
+            auto add_one_for_output() const -> bool
+            {
+                return _add_one_for_output;
+            }
+    };
+
+    /**
+     * Encode the subgraph of a SparseGraph induced by the given vertices into
+     * a FixedBitGraph. Vertex i of the result is vertices[i].
+     */
+    template <unsigned size_>
+    auto sparse_graph_to_bit_graph(const SparseGraph & graph, const std::vector<int> & vertices, FixedBitGraph<size_> & result) -> void
+    {
+        std::vector<int> position(graph.size(), -1);
+        for (unsigned i = 0 ; i < vertices.size() ; ++i)
+            position[vertices[i]] = i;
+
+        result.resize(vertices.size());
+        for (unsigned i = 0 ; i < vertices.size() ; ++i)
+            for (auto & w : graph.neighbours(vertices[i]))
+                if (-1 != position[w])
+                    result.add_edge(i, position[w]);
+    }
+
+    /**
+     * Build a SparseGraph by making two passes over a file. The read_edges
+     * function is given an InputFile, a callback taking the number of
+     * vertices, and a callback taking an edge, and should parse the file
+     * calling each of these in turn.
+     *
+     * A stream (or a compressed file) can only be read once, so instead we
+     * make a single pass, and keep hold of its edges for filling in.
+     *
+     * \throw GraphFileError
+     */
+    template <typename ReadEdges_>
+    auto read_sparse_graph(const std::string & filename, bool add_one_for_output, const ReadEdges_ & read_edges) -> SparseGraph
+    {
+        SparseGraph result(0, add_one_for_output);
+
+        InputFile first_input{ filename };
+
+        if (first_input.is_stream()) {
+            std::vector<std::pair<int, int> > edges;
+
+            read_edges(first_input,
+                    [&] (int size) { result.resize(size); },
+                    [&] (int a, int b) {
+                        result.count_edge(a, b);
+                        edges.emplace_back(a, b);
+                    });
+
+            result.start_filling();
+            for (auto & edge : edges)
+                result.add_edge(edge.first, edge.second);
+            result.finish();
+
+            return result;
+        }
+
+        read_edges(first_input,
+                [&] (int size) { result.resize(size); },
+                [&] (int a, int b) { result.count_edge(a, b); });
+
+        result.start_filling();
+
+        {
+            InputFile input{ filename };
+            read_edges(input,
+                    [&] (int) { },
+                    [&] (int a, int b) {
+                        if (! result.add_edge(a, b))
+                            throw GraphFileError{ filename, "file changed whilst being read" };
+                    });
+        }
+
+        if (! result.finish())
+            throw GraphFileError{ filename, "file changed whilst being read" };
+
+        return result;
+    }
+}
+
+#endif
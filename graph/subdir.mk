@@ -2,7 +2,9 @@ TARGET := libgraph.a
 
 SOURCES := \
 	bit_graph.cc \
+	bit_kernels.cc \
 	degree_sort.cc \
+	permute_graph.cc \
 	min_width_sort.cc \
 	graph_file_error.cc \
 	adj.cc \
@@ -12,10 +14,15 @@ SOURCES := \
 	metis.cc \
 	mivia.cc \
 	lad.cc \
+	binary.cc \
 	graph.cc \
+	mapped_file.cc \
+	tokeniser.cc \
+	sparse_graph.cc \
 	power.cc \
 	complement.cc \
 	is_clique.cc \
+	is_independent_set.cc \
 	is_club.cc \
 	is_vertex_colouring.cc \
 	file_formats.cc \
@@ -24,5 +31,12 @@ SOURCES := \
 	product.cc \
 	kneighbours.cc \
 	add_dominated_vertices.cc \
-	merge_cliques.cc
+	merge_cliques.cc \
+	graph_profile.cc \
+	graph_writer.cc \
+	random_graph.cc \
+	input_file.cc \
+	detect_format.cc \
+	decompressor.cc \
+	fingerprint.cc
 
@@ -38,13 +38,15 @@ namespace parasols
     {
         using Type = typename std::conditional<n_ * bits_per_word <= 1ul << (8 * sizeof(unsigned char)), unsigned char,
               typename std::conditional<n_ * bits_per_word <= 1ul << (8 * sizeof(unsigned short)), unsigned short,
-                std::false_type>::type>::type;
+                typename std::conditional<n_ * bits_per_word <= 1ull << (8 * sizeof(unsigned int)), unsigned int,
+                  std::false_type>::type>::type>::type;
     };
 
     template <template <unsigned, typename> class Algorithm_, typename Result_, typename Graph_, unsigned... sizes_, typename... Params_>
     auto select_graph_size(const GraphSizes<sizes_...> &, const Graph_ & graph, Params_ && ... params) -> Result_
     {
         if (graph.size() < GraphSizes<sizes_...>::n * bits_per_word) {
+            check_bit_graph_memory_budget(graph.size(), GraphSizes<sizes_...>::n);
             Algorithm_<GraphSizes<sizes_...>::n, typename IndexSizes<GraphSizes<sizes_...>::n>::Type> algorithm{
                 graph, std::forward<Params_>(params)... };
             return algorithm.run();
@@ -61,9 +63,13 @@ namespace parasols
 
     /* This is pretty horrible: in order to avoid dynamic allocation, select
      * the appropriate specialisation for our graph's size. */
-    static_assert(max_graph_words == 1024, "Need to update here if max_graph_size is changed.");
-
+#if PARASOLS_MAX_GRAPH_WORDS == 4096
+    using AllGraphSizes = GraphSizes<1, 2, 3, 4, 5, 6, 7, 8, 16, 20, 24, 28, 32, 64, 128, 256, 512, 1024, 2048, 4096>;
+#elif PARASOLS_MAX_GRAPH_WORDS == 2048
+    using AllGraphSizes = GraphSizes<1, 2, 3, 4, 5, 6, 7, 8, 16, 20, 24, 28, 32, 64, 128, 256, 512, 1024, 2048>;
+#else
     using AllGraphSizes = GraphSizes<1, 2, 3, 4, 5, 6, 7, 8, 16, 20, 24, 28, 32, 64, 128, 256, 512, 1024>;
+#endif
 }
 
 #endif
@@ -0,0 +1,34 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/tokeniser.hh>
+
+#include <atomic>
+
+using namespace parasols;
+
+namespace
+{
+    /**
+     * Below this many bytes, we don't bother with threads.
+     */
+    const constexpr std::size_t parallel_parse_threshold = 1 << 20;
+
+    std::atomic<unsigned> parse_threads{ 0 };
+}
+
+auto parasols::set_text_parse_threads(unsigned n) -> void
+{
+    parse_threads.store(n);
+}
+
+auto parasols::text_parse_threads(std::size_t bytes) -> unsigned
+{
+    if (bytes < parallel_parse_threshold)
+        return 1;
+
+    unsigned n = parse_threads.load();
+    if (0 == n)
+        n = std::thread::hardware_concurrency();
+
+    return std::max(1u, n);
+}
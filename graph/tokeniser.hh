@@ -0,0 +1,263 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_GRAPH_TOKENISER_HH
+#define PARASOLS_GUARD_GRAPH_TOKENISER_HH 1
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <climits>
+
+namespace parasols
+{
+    /**
+     * Whitespace, as far as \s is concerned, except for newlines.
+     */
+    inline auto is_space(char c) -> bool
+    {
+        return ' ' == c || '\t' == c || '\r' == c || '\v' == c || '\f' == c;
+    }
+
+    /**
+     * A cursor over some text, with the scanning operations our text graph
+     * readers need. Nothing is allocated: everything works on pointers into
+     * the text, which usually belongs to an InputFile.
+     */
+    class Tokeniser
+    {
+        private:
+            const char * _p, * _end;
+
+        public:
+            Tokeniser(const char * b, const char * e) :
+                _p(b),
+                _end(e)
+            {
+            }
+
+            /**
+             * Have we used up all of our text?
+             */
+            auto at_end() const -> bool
+            {
+                return _p == _end;
+            }
+
+            /**
+             * Where we are in the text.
+             */
+            auto position() const -> const char *
+            {
+                return _p;
+            }
+
+            /**
+             * The next character. Must not be called at the end.
+             */
+            auto peek() const -> char
+            {
+                return *_p;
+            }
+
+            /**
+             * Everything we have left, for error messages.
+             */
+            auto rest() const -> std::string
+            {
+                return std::string(_p, _end);
+            }
+
+            /**
+             * Move past the current line, returning a Tokeniser over it. The
+             * newline is not included.
+             */
+            auto next_line() -> Tokeniser
+            {
+                auto n = static_cast<const char *>(std::memchr(_p, '\n', _end - _p));
+                Tokeniser result{ _p, n ? n : _end };
+                _p = n ? n + 1 : _end;
+                return result;
+            }
+
+            /**
+             * Skip spaces, but not newlines. Returns true if anything was
+             * skipped.
+             */
+            auto skip_spaces() -> bool
+            {
+                const char * s = _p;
+                while (_p != _end && is_space(*_p))
+                    ++_p;
+                return _p != s;
+            }
+
+            /**
+             * Skip spaces and newlines. Returns true if anything was skipped.
+             */
+            auto skip_whitespace() -> bool
+            {
+                const char * s = _p;
+                while (_p != _end && (is_space(*_p) || '\n' == *_p))
+                    ++_p;
+                return _p != s;
+            }
+
+            /**
+             * Skip a particular character, if it is next.
+             */
+            auto skip_char(char c) -> bool
+            {
+                if (_p == _end || *_p != c)
+                    return false;
+                ++_p;
+                return true;
+            }
+
+            /**
+             * Drop a particular character from the end of our text, if it is
+             * there.
+             */
+            auto skip_trailing_char(char c) -> bool
+            {
+                if (_p == _end || *(_end - 1) != c)
+                    return false;
+                --_end;
+                return true;
+            }
+
+            /**
+             * Skip a particular string, if it is next.
+             */
+            auto skip_word(const char * word) -> bool
+            {
+                std::size_t len = std::strlen(word);
+                if (std::size_t(_end - _p) < len || 0 != std::memcmp(_p, word, len))
+                    return false;
+                _p += len;
+                return true;
+            }
+
+            /**
+             * Read an unsigned decimal number. Returns false, and reads
+             * nothing, if there are no digits. Values too large for an int
+             * come out as INT_MAX.
+             */
+            auto read_number(int & result) -> bool
+            {
+                if (_p == _end || *_p < '0' || *_p > '9')
+                    return false;
+
+                long long v = 0;
+                for ( ; _p != _end && *_p >= '0' && *_p <= '9' ; ++_p)
+                    if (v <= INT_MAX)
+                        v = v * 10 + (*_p - '0');
+
+                result = v > INT_MAX ? INT_MAX : v;
+                return true;
+            }
+
+            /**
+             * Read a decimal number, which may have a sign. Values too large
+             * for an int come out as INT_MAX or -INT_MAX.
+             */
+            auto read_signed_number(int & result) -> bool
+            {
+                const char * s = _p;
+                bool negative = skip_char('-');
+                if (! negative)
+                    skip_char('+');
+
+                if (! read_number(result)) {
+                    _p = s;
+                    return false;
+                }
+
+                if (negative)
+                    result = -result;
+                return true;
+            }
+
+            /**
+             * Read everything up to the next space or newline.
+             */
+            auto read_word() -> Tokeniser
+            {
+                const char * s = _p;
+                while (_p != _end && ! is_space(*_p) && '\n' != *_p)
+                    ++_p;
+                return Tokeniser{ s, _p };
+            }
+
+            /**
+             * Is our text exactly the given string?
+             */
+            auto equals(const char * word) const -> bool
+            {
+                std::size_t len = std::strlen(word);
+                return std::size_t(_end - _p) == len && 0 == std::memcmp(_p, word, len);
+            }
+    };
+
+    /**
+     * How many threads should be used to parse big files? Zero, the default,
+     * means one per hardware thread.
+     */
+    auto set_text_parse_threads(unsigned n) -> void;
+
+    /**
+     * How many threads will be used to parse a file with this many bytes
+     * still to go?
+     */
+    auto text_parse_threads(std::size_t bytes) -> unsigned;
+
+    /**
+     * Split some text into line-aligned chunks, and call parse_chunk(begin,
+     * end, result) on each chunk. If the text is big enough, this is done in
+     * parallel. The results are returned in text order, so a reader can
+     * apply them sequentially, and report the first error it finds.
+     */
+    template <typename Chunk_, typename ParseChunk_>
+    auto parse_chunks(const char * begin, const char * end, const ParseChunk_ & parse_chunk) -> std::vector<Chunk_>
+    {
+        unsigned n_chunks = text_parse_threads(end - begin);
+
+        std::vector<const char *> boundaries{ begin };
+        for (unsigned c = 1 ; c < n_chunks ; ++c) {
+            Tokeniser t{ std::max(boundaries.back(), begin + (end - begin) / n_chunks * c), end };
+            if (t.position() != begin && '\n' != *(t.position() - 1))
+                t.next_line();
+            boundaries.push_back(t.position());
+        }
+        boundaries.push_back(end);
+
+        std::vector<Chunk_> chunks(n_chunks);
+        std::vector<std::thread> threads;
+        for (unsigned c = 1 ; c < n_chunks ; ++c)
+            threads.emplace_back([&, c] () {
+                    parse_chunk(boundaries[c], boundaries[c + 1], chunks[c]);
+                    });
+
+        parse_chunk(boundaries[0], boundaries[1], chunks[0]);
+
+        for (auto & t : threads)
+            t.join();
+
+        return chunks;
+    }
+
+    /**
+     * The edges from a chunk of a file, and the first problem in that chunk,
+     * if there was one. If there was a problem, every edge before it in the
+     * chunk is present.
+     */
+    struct ParsedEdges
+    {
+        std::vector<std::pair<int, int> > edges;
+        std::string error;
+    };
+}
+
+#endif
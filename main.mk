@@ -7,9 +7,11 @@ SUBMAKEFILES := \
 	max_labelled_clique/subdir.mk \
 	programs/about_graph/subdir.mk \
 	programs/combine_graphs/subdir.mk \
+	programs/convert_graph/subdir.mk \
 	programs/create_random_bipartite_graph/subdir.mk \
 	programs/create_random_graph/subdir.mk \
 	programs/create_graph_product/subdir.mk \
+	programs/graph_read_benchmark/subdir.mk \
 	programs/max_biclique_speedup_graph/subdir.mk \
 	programs/max_clique_graph/subdir.mk \
 	programs/max_clique_speedup_graph/subdir.mk \
@@ -36,6 +38,27 @@ boost_ldlibs := -lboost_regex -lboost_thread -lboost_system -lboost_program_opti
 
 boost_mpi_ldlibs := -lboost_mpi -lboost_serialization
 
-override CXXFLAGS += -O3 -march=native -std=c++14 -I./ -W -Wall -pthread -g
+# Largest FixedBitGraph width, in words: 1024, 2048 or 4096. Bigger widths
+# allow bigger graphs for the fixed width solvers, at the cost of compile time.
+max_graph_words ?= 1024
+
+# What to compile for. The default only runs on machines like this one; use,
+# say, arch_flags=-march=x86-64-v2 for binaries which run anywhere. Big bit
+# graphs pick AVX2 or AVX-512 code at startup either way.
+arch_flags ?= -march=native
+
+override CXXFLAGS += -O3 $(arch_flags) -std=c++14 -I./ -W -Wall -pthread -g -DPARASOLS_MAX_GRAPH_WORDS=$(max_graph_words)
 override LDFLAGS += -pthread
 
+# Anything linking libgraph also needs these, for reading compressed graph
+# files. We read zstd files too if zstd.h can be found; set have_zstd to 1 or
+# 0 to override this.
+have_zstd ?= $(shell printf '\043include <zstd.h>\n' | $(CXX) -E -x c++ - >/dev/null 2>&1 && echo 1)
+
+graph_ldlibs := -lz
+
+ifeq ($(have_zstd),1)
+    override CXXFLAGS += -DPARASOLS_HAVE_ZSTD
+    graph_ldlibs += -lzstd
+endif
+
@@ -17,8 +17,37 @@ namespace parasols
     auto clique_cover(
             const FixedBitGraph<size_> & graph,
             const FixedBitSet<size_> & p,
-            std::array<unsigned, size_ * bits_per_word> & p_order,
-            std::array<unsigned, size_ * bits_per_word> & result) -> void;
+            VertexArray<unsigned, size_> & p_order,
+            VertexArray<unsigned, size_> & result) -> void
+    {
+        FixedBitSet<size_> p_left = p; // not cliqued yet
+        int clique = 0;                // current clique
+        int i = 0;                     // position in result
+
+        // while we've things left to clique
+        while (! p_left.empty()) {
+            // next clique
+            ++clique;
+            // things that can still be given this clique
+            FixedBitSet<size_> q = p_left;
+
+            // while we can still give something this clique
+            while (! q.empty()) {
+                // first thing we can clique
+                int v = q.first_set_bit();
+                p_left.unset(v);
+                q.unset(v);
+
+                // can't give anything nonadjacent to this the same clique
+                graph.intersect_with_row(v, q);
+
+                // record in result
+                result[i] = clique;
+                p_order[i] = v;
+                ++i;
+            }
+        }
+    }
 }
 
 #endif
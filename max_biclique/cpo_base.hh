@@ -4,6 +4,7 @@
 #define PARASOLS_GUARD_MAX_BICLIQUE_CPO_BASE_HH 1
 
 #include <graph/bit_graph.hh>
+#include <graph/permute_graph.hh>
 #include <cco/cco_mixin.hh>
 #include <max_biclique/max_biclique_params.hh>
 #include <max_biclique/max_biclique_result.hh>
@@ -33,12 +34,7 @@ namespace parasols
             params.order_function(g, order);
 
             // re-encode graph as a bit graph
-            graph.resize(g.size());
-
-            for (int i = 0 ; i < g.size() ; ++i)
-                for (int j = 0 ; j < g.size() ; ++j)
-                    if (g.adjacent(order[i], order[j]))
-                        graph.add_edge(i, j);
+            permute_graph(g, order, graph);
         }
 
         template <typename... MoreArgs_>
@@ -48,8 +44,8 @@ namespace parasols
                 FixedBitSet<size_> & pa,
                 FixedBitSet<size_> & pb,
                 FixedBitSet<size_> & sym_skip,
-                const std::array<VertexType_, size_ * bits_per_word> & pa_order,
-                const std::array<VertexType_, size_ * bits_per_word> & pa_bound,
+                const VertexArray<VertexType_, size_> & pa_order,
+                const VertexArray<VertexType_, size_> & pa_bound,
                 std::vector<int> & position,
                 MoreArgs_ && ... more_args_
                 ) -> void
@@ -98,8 +94,8 @@ namespace parasols
 
                     if (! new_pb.empty()) {
                         position.push_back(0);
-                        std::array<VertexType_, size_ * bits_per_word> new_pb_order;
-                        std::array<VertexType_, size_ * bits_per_word> new_pb_bound;
+                        VertexArray<VertexType_, size_> new_pb_order;
+                        VertexArray<VertexType_, size_> new_pb_bound;
                         colour_class_order(SelectColourClassOrderOverload<perm_>(), new_pb, new_pb_order, new_pb_bound);
                         keep_going = static_cast<ActualType_ *>(this)->recurse(
                                 cb, ca, new_pb, new_pa, sym_skip, new_pb_order, new_pb_bound, position, std::forward<MoreArgs_>(more_args_)...) && keep_going;
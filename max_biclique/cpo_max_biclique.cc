@@ -50,8 +50,8 @@ namespace
             positions.push_back(0);
 
             // initial colouring
-            std::array<VertexType_, size_ * bits_per_word> initial_p_order;
-            std::array<VertexType_, size_ * bits_per_word> initial_bound;
+            VertexArray<VertexType_, size_> initial_p_order;
+            VertexArray<VertexType_, size_> initial_bound;
             colour_class_order(SelectColourClassOrderOverload<perm_>(), pa, initial_p_order, initial_bound);
 
             // go!
@@ -71,8 +71,8 @@ namespace
                 FixedBitSet<size_> & pa,
                 FixedBitSet<size_> & pb,
                 FixedBitSet<size_> & sym_skip,
-                const std::array<VertexType_, size_ * bits_per_word> & pa_order,
-                const std::array<VertexType_, size_ * bits_per_word> & pa_bounds,
+                const VertexArray<VertexType_, size_> & pa_order,
+                const VertexArray<VertexType_, size_> & pa_bounds,
                 std::vector<int> & position
                 ) -> bool
         {
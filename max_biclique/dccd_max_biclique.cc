@@ -5,6 +5,7 @@
 #include <max_biclique/clique_cover.hh>
 
 #include <graph/bit_graph.hh>
+#include <graph/permute_graph.hh>
 
 #include <threads/atomic_incumbent.hh>
 #include <threads/queue.hh>
@@ -176,7 +177,7 @@ namespace
     {
         ++result.nodes;
 
-        std::array<unsigned, size_ * bits_per_word> pa_order, cliques;
+        VertexArray<unsigned, size_> pa_order, cliques;
         clique_cover<size_>(graph, pa, pa_order, cliques);
 
         unsigned ca_popcount = ca.popcount();
@@ -347,14 +348,11 @@ namespace
         std::iota(o.begin(), o.end(), 0);
         params.order_function(graph, o);
 
+        check_bit_graph_memory_budget(graph.size(), size_);
+
         // re-encode graph as a bit graph
         FixedBitGraph<size_> bit_graph;
-        bit_graph.resize(graph.size());
-
-        for (int i = 0 ; i < graph.size() ; ++i)
-            for (int j = 0 ; j < graph.size() ; ++j)
-                if (graph.adjacent(o[i], o[j]))
-                    bit_graph.add_edge(i, j);
+        permute_graph(graph, o, bit_graph);
 
         return max_biclique<size_, sym_>(bit_graph, o, params);
     }
@@ -365,7 +363,6 @@ auto parasols::dccd_max_biclique(const Graph & graph, const MaxBicliqueParams &
 {
     /* This is pretty horrible: in order to avoid dynamic allocation, select
      * the appropriate specialisation for our graph's size. */
-    static_assert(max_graph_words == 1024, "Need to update here if max_graph_size is changed.");
     if (graph.size() < bits_per_word)
         return dccd<sym_, 1>(graph, params);
     else if (graph.size() < 2 * bits_per_word)
@@ -388,6 +385,14 @@ auto parasols::dccd_max_biclique(const Graph & graph, const MaxBicliqueParams &
         return dccd<sym_, 512>(graph, params);
     else if (graph.size() < 1024 * bits_per_word)
         return dccd<sym_, 1024>(graph, params);
+#if PARASOLS_MAX_GRAPH_WORDS >= 2048
+    else if (graph.size() < 2048 * bits_per_word)
+        return dccd<sym_, 2048>(graph, params);
+#endif
+#if PARASOLS_MAX_GRAPH_WORDS >= 4096
+    else if (graph.size() < 4096 * bits_per_word)
+        return dccd<sym_, 4096>(graph, params);
+#endif
     else
         throw GraphTooBig();
 }
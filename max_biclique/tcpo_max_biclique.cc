@@ -156,8 +156,8 @@ namespace
             std::vector<StealPoints> thread_steal_points(params.n_threads);
 
             // initial colouring
-            std::array<VertexType_, size_ * bits_per_word> initial_p_order;
-            std::array<VertexType_, size_ * bits_per_word> initial_colours;
+            VertexArray<VertexType_, size_> initial_p_order;
+            VertexArray<VertexType_, size_> initial_colours;
             FixedBitSet<size_> initial_p;
             initial_p.set_up_to(graph.size());
             colour_class_order(SelectColourClassOrderOverload<perm_>(), initial_p, initial_p_order, initial_colours);
@@ -257,8 +257,8 @@ namespace
                 FixedBitSet<size_> & pa,
                 FixedBitSet<size_> & pb,
                 FixedBitSet<size_> & sym_skip,
-                const std::array<VertexType_, size_ * bits_per_word> & pa_order,
-                const std::array<VertexType_, size_ * bits_per_word> & pa_bounds,
+                const VertexArray<VertexType_, size_> & pa_order,
+                const VertexArray<VertexType_, size_> & pa_bounds,
                 std::vector<int> & position,
                 MaxBicliqueResult & local_result,
                 Subproblem * const subproblem,
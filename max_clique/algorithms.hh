@@ -5,6 +5,7 @@
 
 #include <max_clique/naive_max_clique.hh>
 #include <max_clique/cco_max_clique.hh>
+#include <max_clique/dcco_max_clique.hh>
 #include <max_clique/tcco_max_clique.hh>
 #include <max_clique/ost_max_clique.hh>
 
@@ -34,6 +35,9 @@ namespace parasols
         std::make_pair( std::string{ "cconma" },    cco_max_clique<CCOPermutations::None, CCOInference::None, CCOMerge::All>),
         std::make_pair( std::string{ "ccodma" },    cco_max_clique<CCOPermutations::Defer1, CCOInference::None, CCOMerge::All>),
 
+        std::make_pair( std::string{ "dccon" },     dcco_max_clique<CCOPermutations::None>),
+        std::make_pair( std::string{ "dccod" },     dcco_max_clique<CCOPermutations::Defer1>),
+
         std::make_pair( std::string{ "tccon" },     tcco_max_clique<CCOPermutations::None, CCOInference::None, false>),
         std::make_pair( std::string{ "tccod" },     tcco_max_clique<CCOPermutations::Defer1, CCOInference::None, false>),
 
@@ -42,6 +46,14 @@ namespace parasols
 
         std::make_pair( std::string{ "ost" },       ost_max_clique)
     };
+
+    auto max_independent_set_algorithms = {
+        std::make_pair( std::string{ "ccon" },      cco_max_independent_set<CCOPermutations::None>),
+        std::make_pair( std::string{ "ccod" },      cco_max_independent_set<CCOPermutations::Defer1>),
+
+        std::make_pair( std::string{ "tccon" },     tcco_max_independent_set<CCOPermutations::None>),
+        std::make_pair( std::string{ "tccod" },     tcco_max_independent_set<CCOPermutations::Defer1>)
+    };
 }
 
 #endif
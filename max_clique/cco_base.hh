@@ -4,6 +4,7 @@
 #define PARASOLS_GUARD_MAX_CLIQUE_CCO_BASE_HH 1
 
 #include <graph/bit_graph.hh>
+#include <graph/permute_graph.hh>
 
 #include <cco/cco.hh>
 #include <cco/cco_mixin.hh>
@@ -23,11 +24,11 @@ namespace parasols
         All
     };
 
-    template <template <CCOPermutations, CCOInference, CCOMerge, unsigned, typename VertexType_> class WhichCCO_,
-             CCOPermutations perm_, CCOInference inference_, CCOMerge merge_>
-    struct ApplyPermInferenceMerge
+    template <template <CCOPermutations, CCOInference, CCOMerge, bool, unsigned, typename VertexType_> class WhichCCO_,
+             CCOPermutations perm_, CCOInference inference_, CCOMerge merge_, bool inverse_>
+    struct ApplyPermInferenceMergeInverse
     {
-        template <unsigned size_, typename VertexType_> using Type = WhichCCO_<perm_, inference_, merge_, size_, VertexType_>;
+        template <unsigned size_, typename VertexType_> using Type = WhichCCO_<perm_, inference_, merge_, inverse_, size_, VertexType_>;
     };
 
     template <template <CCOPermutations, CCOInference, unsigned, typename VertexType_> class WhichCCO_,
@@ -37,11 +38,17 @@ namespace parasols
         template <unsigned size_, typename VertexType_> using Type = WhichCCO_<perm_, inference_, size_, VertexType_>;
     };
 
-    template <CCOPermutations perm_, CCOInference inference_, unsigned size_, typename VertexType_, typename ActualType_>
+    /**
+     * If inverse_ is true, we search the complement of the graph without
+     * building it, to find a maximum independent set.
+     */
+    template <CCOPermutations perm_, CCOInference inference_, bool inverse_, unsigned size_, typename VertexType_, typename ActualType_>
     struct CCOBase :
-        CCOMixin<size_, VertexType_, CCOBase<perm_, inference_, size_, VertexType_, ActualType_>, false>
+        CCOMixin<size_, VertexType_, CCOBase<perm_, inference_, inverse_, size_, VertexType_, ActualType_>, inverse_>
     {
-        using CCOMixin<size_, VertexType_, CCOBase<perm_, inference_, size_, VertexType_, ActualType_>, false>::colour_class_order;
+        using CCOMixin<size_, VertexType_, CCOBase<perm_, inference_, inverse_, size_, VertexType_, ActualType_>, inverse_>::colour_class_order;
+
+        static_assert(! inverse_ || CCOInference::None == inference_, "inference_ not implemented for inverse_");
 
         const Graph & original_graph;
         FixedBitGraph<size_> graph;
@@ -60,12 +67,7 @@ namespace parasols
             params.order_function(g, order);
 
             // re-encode graph as a bit graph
-            graph.resize(g.size());
-
-            for (int i = 0 ; i < g.size() ; ++i)
-                for (int j = 0 ; j < g.size() ; ++j)
-                    if (g.adjacent(order[i], order[j]))
-                        graph.add_edge(i, j);
+            permute_graph(g, order, graph);
 
             inferer.preprocess(params, graph);
         }
@@ -74,8 +76,8 @@ namespace parasols
         auto expand(
                 std::vector<unsigned> & c,
                 FixedBitSet<size_> & p,
-                const std::array<VertexType_, size_ * bits_per_word> & p_order,
-                const std::array<VertexType_, size_ * bits_per_word> & colours,
+                const VertexArray<VertexType_, size_> & p_order,
+                const VertexArray<VertexType_, size_> & colours,
                 std::vector<int> & position,
                 MoreArgs_ && ... more_args_
                 ) -> void
@@ -113,17 +115,23 @@ namespace parasols
                     // consider taking v
                     c.push_back(v);
 
-                    // filter p to contain vertices adjacent to v
+                    // filter p to contain vertices adjacent to v (or, if
+                    // inverse_, vertices other than v not adjacent to v)
                     FixedBitSet<size_> new_p = p;
-                    graph.intersect_with_row(v, new_p);
+                    if (inverse_) {
+                        graph.intersect_with_row_complement(v, new_p);
+                        new_p.unset(v);
+                    }
+                    else
+                        graph.intersect_with_row(v, new_p);
 
                     if (new_p.empty()) {
                         static_cast<ActualType_ *>(this)->potential_new_best(c, position, std::forward<MoreArgs_>(more_args_)...);
                     }
                     else {
                         position.push_back(0);
-                        std::array<VertexType_, size_ * bits_per_word> new_p_order;
-                        std::array<VertexType_, size_ * bits_per_word> new_colours;
+                        VertexArray<VertexType_, size_> new_p_order;
+                        VertexArray<VertexType_, size_> new_colours;
                         colour_class_order(SelectColourClassOrderOverload<perm_>(), new_p, new_p_order, new_colours, best_anywhere_value - c.size());
                         keep_going = static_cast<ActualType_ *>(this)->recurse(
                                 c, new_p, new_p_order, new_colours, position, std::forward<MoreArgs_>(more_args_)...) && keep_going;
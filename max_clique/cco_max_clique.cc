@@ -15,10 +15,12 @@ using namespace parasols;
 
 namespace
 {
-    template <CCOPermutations perm_, CCOInference inference_, CCOMerge merge_, unsigned size_, typename VertexType_>
-    struct CCO : CCOBase<perm_, inference_, size_, VertexType_, CCO<perm_, inference_, merge_, size_, VertexType_> >
+    template <CCOPermutations perm_, CCOInference inference_, CCOMerge merge_, bool inverse_, unsigned size_, typename VertexType_>
+    struct CCO : CCOBase<perm_, inference_, inverse_, size_, VertexType_, CCO<perm_, inference_, merge_, inverse_, size_, VertexType_> >
     {
-        using Base = CCOBase<perm_, inference_, size_, VertexType_, CCO<perm_, inference_, merge_, size_, VertexType_> >;
+        using Base = CCOBase<perm_, inference_, inverse_, size_, VertexType_, CCO<perm_, inference_, merge_, inverse_, size_, VertexType_> >;
+
+        static_assert(! inverse_ || CCOMerge::None == merge_, "merge_ not implemented for inverse_");
 
         using Base::CCOBase;
 
@@ -48,8 +50,8 @@ namespace
             positions.push_back(0);
 
             // initial colouring
-            std::array<VertexType_, size_ * bits_per_word> initial_p_order;
-            std::array<VertexType_, size_ * bits_per_word> initial_colours;
+            VertexArray<VertexType_, size_> initial_p_order;
+            VertexArray<VertexType_, size_> initial_colours;
             colour_class_order(SelectColourClassOrderOverload<perm_>(), p, initial_p_order, initial_colours, 0);
             result.initial_colour_bound = initial_colours[graph.size() - 1];
 
@@ -73,8 +75,8 @@ namespace
         auto recurse(
                 std::vector<unsigned> & c,                       // current candidate clique
                 FixedBitSet<size_> & p,
-                const std::array<VertexType_, size_ * bits_per_word> & p_order,
-                const std::array<VertexType_, size_ * bits_per_word> & colours,
+                const VertexArray<VertexType_, size_> & p_order,
+                const VertexArray<VertexType_, size_> & colours,
                 std::vector<int> & position
                 ) -> bool
         {
@@ -164,7 +166,14 @@ namespace
 template <CCOPermutations perm_, CCOInference inference_, CCOMerge merge_>
 auto parasols::cco_max_clique(const Graph & graph, const MaxCliqueParams & params) -> MaxCliqueResult
 {
-    return select_graph_size<ApplyPermInferenceMerge<CCO, perm_, inference_, merge_>::template Type, MaxCliqueResult>(
+    return select_graph_size<ApplyPermInferenceMergeInverse<CCO, perm_, inference_, merge_, false>::template Type, MaxCliqueResult>(
+            AllGraphSizes(), graph, params);
+}
+
+template <CCOPermutations perm_>
+auto parasols::cco_max_independent_set(const Graph & graph, const MaxCliqueParams & params) -> MaxCliqueResult
+{
+    return select_graph_size<ApplyPermInferenceMergeInverse<CCO, perm_, CCOInference::None, CCOMerge::None, true>::template Type, MaxCliqueResult>(
             AllGraphSizes(), graph, params);
 }
 
@@ -185,3 +194,6 @@ template auto parasols::cco_max_clique<CCOPermutations::Defer1, CCOInference::No
 
 template auto parasols::cco_max_clique<CCOPermutations::None, CCOInference::LazyGlobalDomination, CCOMerge::None>(const Graph &, const MaxCliqueParams &) -> MaxCliqueResult;
 template auto parasols::cco_max_clique<CCOPermutations::Defer1, CCOInference::LazyGlobalDomination, CCOMerge::None>(const Graph &, const MaxCliqueParams &) -> MaxCliqueResult;
+
+template auto parasols::cco_max_independent_set<CCOPermutations::None>(const Graph &, const MaxCliqueParams &) -> MaxCliqueResult;
+template auto parasols::cco_max_independent_set<CCOPermutations::Defer1>(const Graph &, const MaxCliqueParams &) -> MaxCliqueResult;
@@ -16,6 +16,13 @@ namespace parasols
      */
     template <CCOPermutations, CCOInference, CCOMerge>
     auto cco_max_clique(const Graph & graph, const MaxCliqueParams & params) -> MaxCliqueResult;
+
+    /**
+     * As cco_max_clique, but finds a maximum independent set, by searching
+     * the complement of graph without building it.
+     */
+    template <CCOPermutations>
+    auto cco_max_independent_set(const Graph & graph, const MaxCliqueParams & params) -> MaxCliqueResult;
 }
 
 #endif
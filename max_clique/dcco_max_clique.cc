@@ -0,0 +1,251 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <max_clique/dcco_max_clique.hh>
+#include <max_clique/print_incumbent.hh>
+
+#include <graph/dynamic_bit_graph.hh>
+#include <graph/permute_graph.hh>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace parasols;
+
+namespace
+{
+    template <CCOPermutations perm_>
+    struct DCCO
+    {
+        const MaxCliqueParams & params;
+        MaxCliqueResult result;
+        std::vector<int> order;
+        DynamicBitGraph graph;
+
+        // pre-allocated space, one entry per depth
+        std::vector<DynamicBitSet> p_alloc;
+        std::vector<std::vector<unsigned> > p_order_alloc, colours_alloc;
+
+        // scratch space for colouring
+        DynamicBitSet p_left, q;
+        std::vector<unsigned> defer;
+
+        DCCO(const Graph & g, const MaxCliqueParams & p) :
+            params(p),
+            order(g.size())
+        {
+            // populate our order with every vertex initially
+            std::iota(order.begin(), order.end(), 0);
+            params.order_function(g, order);
+
+            // re-encode graph as a bit graph
+            permute_graph(g, order, graph);
+
+            // entries are only created when we first reach a given depth,
+            // but they must never move once they exist
+            p_alloc.reserve(graph.size() + 1);
+            p_order_alloc.reserve(graph.size() + 1);
+            colours_alloc.reserve(graph.size() + 1);
+
+            p_left.resize_words(graph.words_per_row());
+            q.resize_words(graph.words_per_row());
+            defer.resize(graph.size());
+        }
+
+        auto allocate_depth(unsigned depth) -> void
+        {
+            while (p_alloc.size() <= depth) {
+                p_alloc.emplace_back(graph.words_per_row());
+                p_order_alloc.emplace_back(graph.size());
+                colours_alloc.emplace_back(graph.size());
+            }
+        }
+
+        auto colour_class_order(
+                const DynamicBitSet & p,
+                std::vector<unsigned> & p_order,
+                std::vector<unsigned> & p_bounds) -> void
+        {
+            // This works on words directly. Bits are only ever removed from
+            // p_left and q, so once a leading word is empty it can be
+            // skipped for good.
+            p_left = p;             // not coloured yet
+            const int n_words = graph.words_per_row();
+            BitWord * p_left_words = p_left.words();
+            BitWord * q_words = q.words();
+
+            unsigned colour = 0;    // current colour
+            unsigned i = 0;         // position in p_bounds
+            unsigned d = 0;         // number deferred
+            int p_left_start = 0;   // words before this in p_left are empty
+
+            // while we've things left to colour
+            while (true) {
+                while (p_left_start < n_words && 0 == p_left_words[p_left_start])
+                    ++p_left_start;
+                if (p_left_start == n_words)
+                    break;
+
+                // next colour
+                ++colour;
+                // things that can still be given this colour
+                std::copy(p_left_words + p_left_start, p_left_words + n_words, q_words + p_left_start);
+                int q_start = p_left_start;
+
+                // while we can still give something this colour
+                unsigned number_with_this_colour = 0;
+                while (true) {
+                    while (q_start < n_words && 0 == q_words[q_start])
+                        ++q_start;
+                    if (q_start == n_words)
+                        break;
+
+                    // first thing we can colour
+                    int b = __builtin_ctzll(q_words[q_start]);
+                    int v = q_start * bits_per_word + b;
+                    p_left_words[q_start] &= ~(BitWord{ 1 } << b);
+                    q_words[q_start] &= ~(BitWord{ 1 } << b);
+
+                    // can't give anything adjacent to this the same colour
+                    const BitWord * row = graph.neighbourhood_words(v);
+                    for (int w = q_start ; w < n_words ; ++w)
+                        q_words[w] &= ~row[w];
+
+                    // record in result
+                    p_bounds[i] = colour;
+                    p_order[i] = v;
+                    ++i;
+                    ++number_with_this_colour;
+                }
+
+                if (perm_ == CCOPermutations::Defer1 && 1 == number_with_this_colour) {
+                    --i;
+                    --colour;
+                    defer[d++] = p_order[i];
+                }
+            }
+
+            for (unsigned n = 0 ; n < d ; ++n) {
+                ++colour;
+                p_order[i] = defer[n];
+                p_bounds[i] = colour;
+                i++;
+            }
+        }
+
+        auto expand(
+                unsigned depth,
+                std::vector<unsigned> & c,
+                std::vector<int> & position
+                ) -> void
+        {
+            ++result.nodes;
+
+            DynamicBitSet & p = p_alloc[depth];
+            const std::vector<unsigned> & p_order = p_order_alloc[depth];
+            const std::vector<unsigned> & colours = colours_alloc[depth];
+
+            // for each v in p... (v comes later)
+            bool first = true;
+            for (int n = p.popcount() - 1 ; n >= 0 ; --n) {
+                ++position.back();
+
+                // bound, timeout or early exit?
+                if (c.size() + colours[n] <= result.size || result.size >= params.stop_after_finding || params.abort->load())
+                    return;
+
+                auto v = p_order[n];
+
+                if (params.vertex_transitive && c.empty() && ! first) {
+                    p.unset(v);
+                }
+                else {
+                    // consider taking v
+                    c.push_back(v);
+
+                    // filter p to contain vertices adjacent to v
+                    allocate_depth(depth + 1);
+                    DynamicBitSet & new_p = p_alloc[depth + 1];
+                    new_p.assign_intersection(p, graph.neighbourhood_words(v));
+
+                    if (new_p.empty()) {
+                        potential_new_best(c, position);
+                    }
+                    else {
+                        position.push_back(0);
+                        colour_class_order(new_p, p_order_alloc[depth + 1], colours_alloc[depth + 1]);
+                        expand(depth + 1, c, position);
+                        position.pop_back();
+                    }
+
+                    // now consider not taking v
+                    c.pop_back();
+                    p.unset(v);
+                }
+
+                first = false;
+            }
+        }
+
+        auto potential_new_best(
+                const std::vector<unsigned> & c,
+                const std::vector<int> & position) -> void
+        {
+            if (c.size() > result.size) {
+                if (params.enumerate) {
+                    ++result.result_count;
+                    result.size = c.size() - 1;
+                }
+                else
+                    result.size = c.size();
+
+                result.members.clear();
+                for (auto & v : c)
+                    result.members.insert(order[v]);
+
+                print_incumbent(params, c.size(), position, result.members);
+            }
+        }
+
+        auto run() -> MaxCliqueResult
+        {
+            result.size = params.initial_bound;
+
+            std::vector<unsigned> c;
+            c.reserve(graph.size());
+
+            std::vector<int> positions;
+            positions.reserve(graph.size());
+            positions.push_back(0);
+
+            if (0 == graph.size())
+                return result;
+
+            // initial colouring
+            allocate_depth(0);
+            p_alloc[0].set_up_to(graph.size());
+            colour_class_order(p_alloc[0], p_order_alloc[0], colours_alloc[0]);
+            result.initial_colour_bound = colours_alloc[0][graph.size() - 1];
+
+            print_position(params, "initial colouring used " + std::to_string(result.initial_colour_bound), std::vector<int>{ });
+
+            // go!
+            expand(0, c, positions);
+
+            // hack for enumerate
+            if (params.enumerate)
+                result.size = result.members.size();
+
+            return result;
+        }
+    };
+}
+
+template <CCOPermutations perm_>
+auto parasols::dcco_max_clique(const Graph & graph, const MaxCliqueParams & params) -> MaxCliqueResult
+{
+    DCCO<perm_> algorithm{ graph, params };
+    return algorithm.run();
+}
+
+template auto parasols::dcco_max_clique<CCOPermutations::None>(const Graph &, const MaxCliqueParams &) -> MaxCliqueResult;
+template auto parasols::dcco_max_clique<CCOPermutations::Defer1>(const Graph &, const MaxCliqueParams &) -> MaxCliqueResult;
@@ -0,0 +1,23 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_MAX_CLIQUE_DCCO_MAX_CLIQUE_HH
+#define PARASOLS_GUARD_MAX_CLIQUE_DCCO_MAX_CLIQUE_HH 1
+
+#include <graph/graph.hh>
+#include <cco/cco.hh>
+#include <max_clique/max_clique_params.hh>
+#include <max_clique/max_clique_result.hh>
+
+namespace parasols
+{
+    /**
+     * The same as cco_max_clique (with no inference or merging), but using
+     * bitsets whose width is chosen at runtime to exactly fit the graph,
+     * rather than the next size up from AllGraphSizes. Only the None and
+     * Defer1 permutations are supported.
+     */
+    template <CCOPermutations>
+    auto dcco_max_clique(const Graph & graph, const MaxCliqueParams & params) -> MaxCliqueResult;
+}
+
+#endif
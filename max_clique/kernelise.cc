@@ -0,0 +1,270 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <max_clique/kernelise.hh>
+#include <graph/permute_graph.hh>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace parasols;
+
+namespace
+{
+    /* How many vertices we try to start from, each time we greedily look
+     * for a clique. */
+    const constexpr unsigned greedy_starts = 32;
+
+    /* Dominance checks stop after this many words of subset tests per
+     * vertex, on average, so that big dense graphs don't take forever. */
+    const constexpr long long dominance_words_per_vertex = 1 << 12;
+
+    class Kerneliser
+    {
+        private:
+            const Graph & _graph;
+            const int _words;
+            const unsigned _initial_bound;
+
+            std::vector<BitWord> _alive;
+            std::vector<int> _degree;
+            std::vector<int> _queue;
+            std::vector<bool> _queued;
+            long long _dominance_budget;
+
+            auto _k() const -> unsigned
+            {
+                return std::max<unsigned>(_initial_bound, incumbent.size());
+            }
+
+            auto _is_alive(int v) const -> bool
+            {
+                return _alive[v / bits_per_word] & (BitWord{ 1 } << (v % bits_per_word));
+            }
+
+            /**
+             * Call f(w) for each w set in both a and b.
+             */
+            template <typename F_>
+            auto _for_each_in_both(const BitWord * a, const BitWord * b, const F_ & f) const -> void
+            {
+                for (int i = 0 ; i < _words ; ++i) {
+                    BitWord bits = a[i] & b[i];
+                    while (0 != bits) {
+                        int c = __builtin_ctzll(bits);
+                        bits &= bits - 1;
+                        f(i * bits_per_word + c);
+                    }
+                }
+            }
+
+            auto _enqueue(int v) -> void
+            {
+                if (! _queued[v]) {
+                    _queued[v] = true;
+                    _queue.push_back(v);
+                }
+            }
+
+            auto _remove(int v) -> void
+            {
+                _alive[v / bits_per_word] &= ~(BitWord{ 1 } << (v % bits_per_word));
+
+                _for_each_in_both(_graph.neighbourhood_words(v), _alive.data(), [&] (int w) {
+                        if (unsigned(--_degree[w]) < _k())
+                            _enqueue(w);
+                        });
+            }
+
+            /**
+             * Remove everything queued, and anything that that leaves with
+             * too few neighbours.
+             */
+            auto _peel_queue() -> void
+            {
+                while (! _queue.empty()) {
+                    int v = _queue.back();
+                    _queue.pop_back();
+                    if (_is_alive(v)) {
+                        _remove(v);
+                        ++peeled;
+                    }
+                }
+            }
+
+            auto _alive_vertices() const -> std::vector<int>
+            {
+                std::vector<int> result;
+                for (int v = 0 ; v < _graph.size() ; ++v)
+                    if (_is_alive(v))
+                        result.push_back(v);
+                return result;
+            }
+
+        public:
+            std::set<int> incumbent;
+            unsigned peeled = 0, dominated = 0;
+
+            Kerneliser(const Graph & graph, unsigned initial_bound) :
+                _graph(graph),
+                _words(graph.words_per_row()),
+                _initial_bound(initial_bound),
+                _alive(graph.words_per_row(), 0),
+                _degree(graph.size()),
+                _queued(graph.size(), false),
+                _dominance_budget(dominance_words_per_vertex * graph.size())
+            {
+                for (int v = 0 ; v < graph.size() ; ++v) {
+                    _alive[v / bits_per_word] |= (BitWord{ 1 } << (v % bits_per_word));
+                    _degree[v] = graph.degree(v) - (graph.adjacent(v, v) ? 1 : 0);
+                }
+            }
+
+            /**
+             * Try to improve the incumbent, by starting from each of the
+             * highest degree vertices and greedily adding vertices in
+             * degree order. Returns true if we did.
+             */
+            auto greedy() -> bool
+            {
+                auto order = _alive_vertices();
+                std::stable_sort(order.begin(), order.end(), [&] (int a, int b) { return _degree[a] > _degree[b]; });
+
+                bool improved = false;
+                std::vector<BitWord> p(_words);
+                for (unsigned s = 0 ; s < std::min<unsigned>(greedy_starts, order.size()) ; ++s) {
+                    const BitWord * row = _graph.neighbourhood_words(order[s]);
+                    for (int i = 0 ; i < _words ; ++i)
+                        p[i] = row[i] & _alive[i];
+
+                    std::set<int> clique{ order[s] };
+                    for (auto & v : order) {
+                        if (p[v / bits_per_word] & (BitWord{ 1 } << (v % bits_per_word))) {
+                            clique.insert(v);
+                            const BitWord * v_row = _graph.neighbourhood_words(v);
+                            for (int i = 0 ; i < _words ; ++i)
+                                p[i] &= v_row[i];
+                        }
+                    }
+
+                    if (clique.size() > incumbent.size()) {
+                        incumbent = std::move(clique);
+                        improved = true;
+                    }
+                }
+
+                return improved;
+            }
+
+            /**
+             * Peel down to the k-core, where k is the size of the best clique
+             * we know about.
+             */
+            auto peel() -> void
+            {
+                for (int v = 0 ; v < _graph.size() ; ++v)
+                    if (_is_alive(v) && unsigned(_degree[v]) < _k())
+                        _enqueue(v);
+
+                _peel_queue();
+            }
+
+            /**
+             * Remove dominated vertices, peeling as we go. Returns true if we
+             * removed anything.
+             */
+            auto remove_dominated() -> bool
+            {
+                auto order = _alive_vertices();
+                std::stable_sort(order.begin(), order.end(), [&] (int a, int b) { return _degree[a] < _degree[b]; });
+
+                bool removed_any = false;
+                std::vector<BitWord> u_row(_words), candidates(_words);
+                for (auto & u : order) {
+                    if (! _is_alive(u))
+                        continue;
+
+                    /* Anything dominating u must be adjacent to all of u's
+                     * neighbours, and in particular to its neighbour of
+                     * lowest degree, w. */
+                    const BitWord * row = _graph.neighbourhood_words(u);
+                    int w = -1;
+                    for (int i = 0 ; i < _words ; ++i)
+                        u_row[i] = row[i] & _alive[i];
+                    _for_each_in_both(u_row.data(), _alive.data(), [&] (int x) {
+                            if (-1 == w || _degree[x] < _degree[w])
+                                w = x;
+                            });
+                    if (-1 == w)
+                        continue;
+
+                    const BitWord * w_row = _graph.neighbourhood_words(w);
+                    for (int i = 0 ; i < _words ; ++i)
+                        candidates[i] = w_row[i] & _alive[i] & ~row[i];
+                    candidates[u / bits_per_word] &= ~(BitWord{ 1 } << (u % bits_per_word));
+
+                    bool is_dominated = false;
+                    for (int i = 0 ; i < _words && ! is_dominated ; ++i) {
+                        BitWord bits = candidates[i];
+                        while (0 != bits && ! is_dominated) {
+                            int v = i * bits_per_word + __builtin_ctzll(bits);
+                            bits &= bits - 1;
+
+                            _dominance_budget -= _words;
+                            if (_dominance_budget < 0)
+                                return removed_any;
+
+                            const BitWord * v_row = _graph.neighbourhood_words(v);
+                            is_dominated = true;
+                            for (int j = 0 ; j < _words ; ++j)
+                                if (0 != (u_row[j] & ~v_row[j])) {
+                                    is_dominated = false;
+                                    break;
+                                }
+                        }
+                    }
+
+                    if (is_dominated) {
+                        _remove(u);
+                        ++dominated;
+                        removed_any = true;
+                        _peel_queue();
+                    }
+                }
+
+                return removed_any;
+            }
+
+            auto vertices() const -> std::vector<int>
+            {
+                return _alive_vertices();
+            }
+    };
+}
+
+auto parasols::kernelise_max_clique(const Graph & graph, unsigned initial_bound) -> MaxCliqueKernel
+{
+    Kerneliser kerneliser{ graph, initial_bound };
+
+    bool changed = true;
+    while (changed) {
+        changed = kerneliser.greedy();
+        kerneliser.peel();
+        changed = kerneliser.remove_dominated() || changed;
+    }
+
+    auto vertices = kerneliser.vertices();
+    MaxCliqueKernel result{ Graph(vertices.size(), graph.add_one_for_output()), vertices,
+        std::move(kerneliser.incumbent), kerneliser.peeled, kerneliser.dominated };
+
+    /* Build the rows of what's left. */
+    auto position = inverse_order(graph, vertices);
+    for_each_row_range(vertices.size(), [&] (int begin, int end) {
+            std::vector<BitWord> row(result.graph.words_per_row());
+            for (int i = begin ; i < end ; ++i) {
+                encode_permuted_row(graph, vertices[i], position, row.data(), row.size());
+                result.graph.set_neighbourhood_words(i, row.data());
+            }
+            });
+
+    return result;
+}
@@ -0,0 +1,47 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_MAX_CLIQUE_KERNELISE_HH
+#define PARASOLS_GUARD_MAX_CLIQUE_KERNELISE_HH 1
+
+#include <graph/graph.hh>
+
+#include <vector>
+#include <set>
+
+namespace parasols
+{
+    /**
+     * The result of kernelise_max_clique().
+     */
+    struct MaxCliqueKernel
+    {
+        /// What is left to search.
+        Graph graph;
+
+        /// Vertex i of graph is vertex vertices[i] of the original graph.
+        std::vector<int> vertices;
+
+        /// The best clique we found along the way, as original vertices.
+        std::set<int> incumbent;
+
+        /// How many vertices were removed by each rule.
+        unsigned peeled = 0, dominated = 0;
+    };
+
+    /**
+     * Shrink graph to a kernel which contains a maximum clique of graph,
+     * unless no clique is bigger than both incumbent and initial_bound.
+     *
+     * We alternate between greedily finding cliques, and removing vertices
+     * using two rules, until nothing changes. If k is the size of the best
+     * clique so far, a vertex with fewer than k neighbours can't be in a
+     * bigger clique, so we peel the graph down to its k-core. A vertex u is
+     * dominated by a vertex v which isn't adjacent to it if every neighbour
+     * of u is also a neighbour of v, since v can then replace u in any
+     * clique; this includes u and v being twins, in which case we only
+     * remove one of them. Each time the incumbent improves, we peel again.
+     */
+    auto kernelise_max_clique(const Graph & graph, unsigned initial_bound) -> MaxCliqueKernel;
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include <max_clique/ost_max_clique.hh>
 #include <max_clique/print_incumbent.hh>
 #include <graph/bit_graph.hh>
+#include <graph/permute_graph.hh>
 #include <graph/template_voodoo.hh>
 #include <numeric>
 
@@ -29,12 +30,7 @@ namespace
             params.order_function(g, order);
 
             // re-encode graph as a bit graph
-            graph.resize(g.size());
-
-            for (int i = 0 ; i < g.size() ; ++i)
-                for (int j = 0 ; j < g.size() ; ++j)
-                    if (g.adjacent(order[i], order[j]))
-                        graph.add_edge(i, j);
+            permute_graph(g, order, graph);
         }
 
         auto expand(
@@ -3,6 +3,7 @@ TARGET := libmax_clique.a
 SOURCES := \
 	cco_base.cc \
 	cco_max_clique.cc \
+	dcco_max_clique.cc \
 	cco_inference.cc \
 	tcco_max_clique.cc \
 	ost_max_clique.cc \
@@ -10,5 +11,6 @@ SOURCES := \
 	max_clique_result.cc \
 	naive_max_clique.cc \
 	print_incumbent.cc \
+	kernelise.cc \
 	algorithms.cc
 
@@ -195,10 +195,12 @@ namespace
         }
     };
 
-    template <CCOPermutations perm_, CCOInference inference_, bool merge_queue_, unsigned size_, typename VertexType_>
-    struct TCCO : CCOBase<perm_, inference_, size_, VertexType_, TCCO<perm_, inference_, merge_queue_, size_, VertexType_> >
+    template <CCOPermutations perm_, CCOInference inference_, bool merge_queue_, bool inverse_, unsigned size_, typename VertexType_>
+    struct TCCO : CCOBase<perm_, inference_, inverse_, size_, VertexType_, TCCO<perm_, inference_, merge_queue_, inverse_, size_, VertexType_> >
     {
-        using Base = CCOBase<perm_, inference_, size_, VertexType_, TCCO<perm_, inference_, merge_queue_, size_, VertexType_> >;
+        using Base = CCOBase<perm_, inference_, inverse_, size_, VertexType_, TCCO<perm_, inference_, merge_queue_, inverse_, size_, VertexType_> >;
+
+        static_assert(! inverse_ || ! merge_queue_, "merge_queue_ not implemented for inverse_");
 
         using Base::graph;
         using Base::original_graph;
@@ -243,8 +245,8 @@ namespace
             std::vector<StealPoints> thread_steal_points(params.n_threads);
 
             // initial colouring
-            std::array<VertexType_, size_ * bits_per_word> initial_p_order;
-            std::array<VertexType_, size_ * bits_per_word> initial_colours;
+            VertexArray<VertexType_, size_> initial_p_order;
+            VertexArray<VertexType_, size_> initial_colours;
             {
                 FixedBitSet<size_> initial_p;
                 initial_p.set_up_to(graph.size());
@@ -342,8 +344,8 @@ namespace
         auto recurse(
                 std::vector<unsigned> & c,
                 FixedBitSet<size_> & p,
-                const std::array<VertexType_, size_ * bits_per_word> & initial_p_order,
-                const std::array<VertexType_, size_ * bits_per_word> & initial_colours,
+                const VertexArray<VertexType_, size_> & initial_p_order,
+                const VertexArray<VertexType_, size_> & initial_colours,
                 std::vector<int> & position,
                 MaxCliqueResult & local_result,
                 Subproblem * const subproblem,
@@ -419,7 +421,14 @@ namespace
 template <CCOPermutations perm_, CCOInference inference_, bool merge_queue_>
 auto parasols::tcco_max_clique(const Graph & graph, const MaxCliqueParams & params) -> MaxCliqueResult
 {
-    return select_graph_size<ApplyPermInferenceMQ<TCCO, perm_, inference_, merge_queue_>::template Type, MaxCliqueResult>(
+    return select_graph_size<ApplyPermInferenceMQInverse<TCCO, perm_, inference_, merge_queue_, false>::template Type, MaxCliqueResult>(
+            AllGraphSizes(), graph, params);
+}
+
+template <CCOPermutations perm_>
+auto parasols::tcco_max_independent_set(const Graph & graph, const MaxCliqueParams & params) -> MaxCliqueResult
+{
+    return select_graph_size<ApplyPermInferenceMQInverse<TCCO, perm_, CCOInference::None, false, true>::template Type, MaxCliqueResult>(
             AllGraphSizes(), graph, params);
 }
 
@@ -429,3 +438,5 @@ template auto parasols::tcco_max_clique<CCOPermutations::Defer1, CCOInference::N
 template auto parasols::tcco_max_clique<CCOPermutations::None, CCOInference::None, true>(const Graph &, const MaxCliqueParams &) -> MaxCliqueResult;
 template auto parasols::tcco_max_clique<CCOPermutations::Defer1, CCOInference::None, true>(const Graph &, const MaxCliqueParams &) -> MaxCliqueResult;
 
+template auto parasols::tcco_max_independent_set<CCOPermutations::None>(const Graph &, const MaxCliqueParams &) -> MaxCliqueResult;
+template auto parasols::tcco_max_independent_set<CCOPermutations::Defer1>(const Graph &, const MaxCliqueParams &) -> MaxCliqueResult;
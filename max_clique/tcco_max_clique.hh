@@ -17,11 +17,18 @@ namespace parasols
     template <CCOPermutations, CCOInference, bool merge_queue_>
     auto tcco_max_clique(const Graph & graph, const MaxCliqueParams & params) -> MaxCliqueResult;
 
-    template <template <CCOPermutations, CCOInference, bool, unsigned, typename VertexType_> class WhichCCO_,
-             CCOPermutations perm_, CCOInference inference_, bool merge_queue_>
-    struct ApplyPermInferenceMQ
+    /**
+     * As tcco_max_clique, but finds a maximum independent set, by searching
+     * the complement of graph without building it.
+     */
+    template <CCOPermutations>
+    auto tcco_max_independent_set(const Graph & graph, const MaxCliqueParams & params) -> MaxCliqueResult;
+
+    template <template <CCOPermutations, CCOInference, bool, bool, unsigned, typename VertexType_> class WhichCCO_,
+             CCOPermutations perm_, CCOInference inference_, bool merge_queue_, bool inverse_>
+    struct ApplyPermInferenceMQInverse
     {
-        template <unsigned size_, typename VertexType_> using Type = WhichCCO_<perm_, inference_, merge_queue_, size_, VertexType_>;
+        template <unsigned size_, typename VertexType_> using Type = WhichCCO_<perm_, inference_, merge_queue_, inverse_, size_, VertexType_>;
     };
 }
 
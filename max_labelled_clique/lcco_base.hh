@@ -4,6 +4,7 @@
 #define PARASOLS_GUARD_MAX_LABELLED_CLIQUE_LCCO_BASE_HH 1
 
 #include <graph/bit_graph.hh>
+#include <graph/permute_graph.hh>
 
 #include <cco/cco.hh>
 #include <cco/cco_mixin.hh>
@@ -37,12 +38,7 @@ namespace parasols
             params.order_function(g, order);
 
             // re-encode graph as a bit graph
-            graph.resize(g.size());
-
-            for (int i = 0 ; i < g.size() ; ++i)
-                for (int j = 0 ; j < g.size() ; ++j)
-                    if (g.adjacent(order[i], order[j]))
-                        graph.add_edge(i, j);
+            permute_graph(g, order, graph);
 
             for (int i = 0 ; i < g.size() ; ++i)
                 for (int j = 0 ; j < g.size() ; ++j)
@@ -55,8 +51,8 @@ namespace parasols
                 std::vector<VertexType_> & c,                    // current candidate clique
                 FixedBitSet<size_> & p,                          // potential additions
                 LabelSet & u,
-                const std::array<VertexType_, size_ * bits_per_word> & p_order,
-                const std::array<VertexType_, size_ * bits_per_word> & colours,
+                const VertexArray<VertexType_, size_> & p_order,
+                const VertexArray<VertexType_, size_> & colours,
                 std::vector<int> & position,
                 MoreArgs_ && ... more_args_
                 ) -> void
@@ -108,8 +104,8 @@ namespace parasols
 
                         if (! new_p.empty()) {
                             position.push_back(0);
-                            std::array<VertexType_, size_ * bits_per_word> new_p_order;
-                            std::array<VertexType_, size_ * bits_per_word> new_colours;
+                            VertexArray<VertexType_, size_> new_p_order;
+                            VertexArray<VertexType_, size_> new_colours;
                             colour_class_order(SelectColourClassOrderOverload<perm_>(), new_p, new_p_order, new_colours);
                             keep_going = static_cast<ActualType_ *>(this)->recurse(
                                     pass_2, c, new_p, new_u, new_p_order, new_colours, position,
@@ -48,8 +48,8 @@ namespace
 
                 LabelSet u;
 
-                std::array<VertexType_, size_ * bits_per_word> initial_p_order;
-                std::array<VertexType_, size_ * bits_per_word> initial_colours;
+                VertexArray<VertexType_, size_> initial_p_order;
+                VertexArray<VertexType_, size_> initial_colours;
                 colour_class_order(SelectColourClassOrderOverload<perm_>(), p, initial_p_order, initial_colours);
 
                 // go!
@@ -86,8 +86,8 @@ namespace
                 std::vector<VertexType_> & c,
                 FixedBitSet<size_> & p,
                 LabelSet & u,
-                const std::array<VertexType_, size_ * bits_per_word> & p_order,
-                const std::array<VertexType_, size_ * bits_per_word> & colours,
+                const VertexArray<VertexType_, size_> & p_order,
+                const VertexArray<VertexType_, size_> & colours,
                 std::vector<int> & position
                 ) -> bool
         {
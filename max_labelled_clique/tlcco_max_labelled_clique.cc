@@ -156,8 +156,8 @@ namespace
                 std::vector<StealPoints> thread_steal_points(params.n_threads);
 
                 // initial colouring
-                std::array<VertexType_, size_ * bits_per_word> initial_p_order;
-                std::array<VertexType_, size_ * bits_per_word> initial_colours;
+                VertexArray<VertexType_, size_> initial_p_order;
+                VertexArray<VertexType_, size_> initial_colours;
                 {
                     FixedBitSet<size_> initial_p;
                     initial_p.set_up_to(graph.size());
@@ -271,8 +271,8 @@ namespace
                 std::vector<VertexType_> & c,
                 FixedBitSet<size_> & p,
                 LabelSet & u,
-                const std::array<VertexType_, size_ * bits_per_word> & p_order,
-                const std::array<VertexType_, size_ * bits_per_word> & colours,
+                const VertexArray<VertexType_, size_> & p_order,
+                const VertexArray<VertexType_, size_> & colours,
                 std::vector<int> & position,
                 MaxLabelledCliqueResult & local_result,
                 Subproblem * const subproblem,
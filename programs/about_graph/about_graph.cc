@@ -4,6 +4,7 @@
 #include <graph/file_formats.hh>
 #include <graph/power.hh>
 #include <graph/complement.hh>
+#include <graph/graph_profile.hh>
 
 #include <boost/program_options.hpp>
 #include <boost/algorithm/string.hpp>
@@ -24,6 +25,9 @@ auto main(int argc, char * argv[]) -> int
             ("complement",                           "Take the complement of the graph")
             ("power",              po::value<int>(), "Raise the graph to this power")
             ("format",             po::value<std::string>(), "Specify the format of the input")
+            ("sparse",                               "Read the input into a sparse representation (for very large graphs)")
+            ("profile",                              "Also show degeneracy, triangles, clustering, greedy bounds and components")
+            ("json",                                 "Show the profile as JSON, one object per input file (implies --profile)")
             ;
 
         po::options_description all_options{ "All options" };
@@ -60,15 +64,65 @@ auto main(int argc, char * argv[]) -> int
             return EXIT_FAILURE;
         }
 
+        if (options_vars.count("sparse") && (options_vars.count("complement") || options_vars.count("power"))) {
+            std::cerr << "Error: --sparse cannot be combined with --complement or --power" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (options_vars.count("sparse") && (options_vars.count("profile") || options_vars.count("json"))) {
+            std::cerr << "Error: --sparse cannot be combined with --profile or --json" << std::endl;
+            return EXIT_FAILURE;
+        }
+
         /* For each input file... */
         auto input_files = options_vars["input-file"].as<std::vector<std::string> >();
         bool first = true;
         for (auto & input_file : input_files) {
             if (first)
                 first = false;
-            else
+            else if (! options_vars.count("json"))
                 std::cout << "--" << std::endl;
 
+            if (options_vars.count("sparse")) {
+                /* Turn a format name into a runnable function. */
+                auto format = sparse_graph_file_formats.begin(), format_end = sparse_graph_file_formats.end();
+                if (options_vars.count("format"))
+                    for ( ; format != format_end ; ++format)
+                        if (format->first == options_vars["format"].as<std::string>())
+                            break;
+
+                /* Unknown format? Show a message and exit. */
+                if (format == format_end) {
+                    std::cerr << "Unknown sparse format " << options_vars["format"].as<std::string>() << ", choose from:";
+                    for (auto a : sparse_graph_file_formats)
+                        std::cerr << " " << a.first;
+                    std::cerr << std::endl;
+                    return EXIT_FAILURE;
+                }
+
+                /* Read in the graph */
+                auto graph = std::get<1>(*format)(input_file, GraphOptions::AllowLoops);
+
+                unsigned long long loops = 0;
+                unsigned long long mean_deg = 0;
+                unsigned max_deg = 0;
+                for (int i = 0 ; i < graph.size() ; ++i) {
+                    if (graph.adjacent(i, i))
+                        ++loops;
+
+                    mean_deg += graph.degree(i);
+                    max_deg = std::max<unsigned>(max_deg, graph.degree(i));
+                }
+
+                unsigned long long edges = graph.number_of_edges();
+
+                std::cout << graph.size() << " " << edges << " " << loops << " " <<
+                    ((0.0 + mean_deg) / (0.0 + graph.size())) << " " << max_deg << " "
+                     << ((0.0 + 2 * edges) / (0.0 + graph.size()) / (graph.size() - 1.0)) << std::endl;
+
+                continue;
+            }
+
             /* Turn a format name into a runnable function. */
             auto format = graph_file_formats.begin(), format_end = graph_file_formats.end();
             if (options_vars.count("format"))
@@ -94,25 +148,33 @@ auto main(int argc, char * argv[]) -> int
             if (options_vars.count("power"))
                 graph = power(graph, options_vars["power"].as<int>());
 
-            unsigned edges = 0;
-            unsigned loops = 0;
+            if (options_vars.count("json")) {
+                write_profile_json(std::cout, input_file, profile_graph(graph));
+                continue;
+            }
+
+            /* Degrees count loops once, so we don't need to look at every
+             * pair of vertices to count edges. */
+            unsigned long long edges = 0;
+            unsigned long long loops = 0;
             unsigned max_deg = 0;
-            unsigned mean_deg = 0;
+            unsigned long long mean_deg = 0;
             for (int i = 0 ; i < graph.size() ; ++i) {
                 if (graph.adjacent(i, i))
                     ++loops;
 
                 mean_deg += graph.degree(i);
                 max_deg = std::max<unsigned>(max_deg, graph.degree(i));
-
-                for (int j = 0 ; j <= i ; ++j)
-                    if (graph.adjacent(i, j))
-                        ++edges;
             }
 
+            edges = (mean_deg - loops) / 2 + loops;
+
             std::cout << graph.size() << " " << edges << " " << loops << " " <<
                 ((0.0 + mean_deg) / (0.0 + graph.size())) << " " << max_deg << " "
-                 << ((0.0 + 2 * edges) / (graph.size() * (graph.size() - 1))) << std::endl;
+                 << ((0.0 + 2 * edges) / (graph.size() * (graph.size() - 1.0))) << std::endl;
+
+            if (options_vars.count("profile"))
+                write_profile_text(std::cout, profile_graph(graph));
         }
 
         return EXIT_SUCCESS;
@@ -5,11 +5,13 @@
 #include <graph/graph.hh>
 #include <graph/product.hh>
 #include <graph/file_formats.hh>
+#include <graph/output_formats.hh>
 
 #include <iostream>
 #include <exception>
 #include <cstdlib>
 #include <set>
+#include <vector>
 
 using namespace parasols;
 namespace po = boost::program_options;
@@ -21,6 +23,7 @@ auto main(int argc, char * argv[]) -> int
         display_options.add_options()
             ("help",                                         "Display help information")
             ("format",             po::value<std::string>(), "Specify the format of the input")
+            ("output-format",      po::value<std::string>(), "Specify the format of the output (default dimacs)")
             ;
 
         po::options_description all_options{ "All options" };
@@ -73,6 +76,22 @@ auto main(int argc, char * argv[]) -> int
             return EXIT_FAILURE;
         }
 
+        /* Turn an output format name into a runnable function. */
+        auto output_format = graph_writers.begin(), output_format_end = graph_writers.end();
+        if (options_vars.count("output-format"))
+            for ( ; output_format != output_format_end ; ++output_format)
+                if (output_format->first == options_vars["output-format"].as<std::string>())
+                    break;
+
+        /* Unknown output format? Show a message and exit. */
+        if (output_format == output_format_end) {
+            std::cerr << "Unknown output format " << options_vars["output-format"].as<std::string>() << ", choose from:";
+            for (auto a : graph_writers)
+                std::cerr << " " << a.first;
+            std::cerr << std::endl;
+            return EXIT_FAILURE;
+        }
+
         Graph result(0, true);
 
         /* Read in the graphs */
@@ -88,20 +107,17 @@ auto main(int argc, char * argv[]) -> int
                 return EXIT_FAILURE;
             }
 
-            for (int i = 0 ; i < graph.size() ; ++i)
-                for (int j = 0 ; j < graph.size() ; ++j)
-                    if (graph.adjacent(i, j))
-                        result.add_edge(i, j);
-        }
-
-        std::cout << "p edge " << result.size() << " 0" << std::endl;
-        for (int e = 0 ; e < result.size() ; ++e) {
-            for (int f = e + 1 ; f < result.size() ; ++f) {
-                if (result.adjacent(e, f))
-                    std::cout << "e " << (e + 1) << " " << (f + 1) << std::endl;
+            std::vector<BitWord> row(result.words_per_row());
+            for (int i = 0 ; i < graph.size() ; ++i) {
+                auto a = result.neighbourhood_words(i), b = graph.neighbourhood_words(i);
+                for (int w = 0 ; w < result.words_per_row() ; ++w)
+                    row[w] = a[w] | b[w];
+                result.set_neighbourhood_words(i, row.data());
             }
         }
 
+        std::get<1>(*output_format)(std::cout, result);
+
         return EXIT_SUCCESS;
     }
     catch (const po::error & e) {
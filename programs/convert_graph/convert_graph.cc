@@ -0,0 +1,119 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/graph.hh>
+#include <graph/file_formats.hh>
+#include <graph/orders.hh>
+#include <graph/binary.hh>
+
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <exception>
+#include <numeric>
+#include <cstdlib>
+
+using namespace parasols;
+namespace po = boost::program_options;
+
+auto main(int argc, char * argv[]) -> int
+{
+    try {
+        po::options_description display_options{ "Program options" };
+        display_options.add_options()
+            ("help",                                 "Display help information")
+            ("format",             po::value<std::string>(), "Specify the format of the input")
+            ("order",              po::value<std::string>(), "Store the vertices permuted by this order")
+            ;
+
+        po::options_description all_options{ "All options" };
+        all_options.add_options()
+            ("input-file",  po::value<std::string>(), "Specify the input file (DIMACS format, unless --format is specified)")
+            ("output-file", po::value<std::string>(), "Specify the output file (binary format)")
+            ;
+
+        all_options.add(display_options);
+
+        po::positional_options_description positional_options;
+        positional_options
+            .add("input-file", 1)
+            .add("output-file", 1)
+            ;
+
+        po::variables_map options_vars;
+        po::store(po::command_line_parser(argc, argv)
+                .options(all_options)
+                .positional(positional_options)
+                .run(), options_vars);
+        po::notify(options_vars);
+
+        /* --help? Show a message, and exit. */
+        if (options_vars.count("help")) {
+            std::cout << "Usage: " << argv[0] << " [options] input-file output-file" << std::endl;
+            std::cout << std::endl;
+            std::cout << display_options << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        /* No input or output file specified? Show a message and exit. */
+        if (! options_vars.count("input-file") || ! options_vars.count("output-file")) {
+            std::cout << "Usage: " << argv[0] << " [options] input-file output-file" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        /* Turn a format name into a runnable function. */
+        auto format = graph_file_formats.begin(), format_end = graph_file_formats.end();
+        if (options_vars.count("format"))
+            for ( ; format != format_end ; ++format)
+                if (format->first == options_vars["format"].as<std::string>())
+                    break;
+
+        /* Unknown format? Show a message and exit. */
+        if (format == format_end) {
+            std::cerr << "Unknown format " << options_vars["format"].as<std::string>() << ", choose from:";
+            for (auto a : graph_file_formats)
+                std::cerr << " " << a.first;
+            std::cerr << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        /* Turn an order string name into a runnable function. */
+        std::function<void (const Graph &, std::vector<int> &)> order_function;
+        if (options_vars.count("order")) {
+            for (auto order = orders.begin() ; order != orders.end() ; ++order)
+                if (std::get<0>(*order) == options_vars["order"].as<std::string>()) {
+                    order_function = std::get<1>(*order);
+                    break;
+                }
+
+            /* Unknown order? Show a message and exit. */
+            if (! order_function) {
+                std::cerr << "Unknown order " << options_vars["order"].as<std::string>() << ", choose from:";
+                for (auto a : orders)
+                    std::cerr << " " << a.first;
+                std::cerr << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        /* Read in the graph */
+        auto graph = std::get<1>(*format)(options_vars["input-file"].as<std::string>(), GraphOptions::AllowLoops);
+
+        std::vector<int> order(graph.size());
+        std::iota(order.begin(), order.end(), 0);
+        if (order_function)
+            order_function(graph, order);
+
+        write_binary(graph, order, options_vars["output-file"].as<std::string>());
+
+        return EXIT_SUCCESS;
+    }
+    catch (const po::error & e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << "Try " << argv[0] << " --help" << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch (const std::exception & e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
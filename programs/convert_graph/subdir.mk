@@ -0,0 +1,8 @@
+TARGET := convert_graph
+
+SOURCES := convert_graph.cc
+
+TGT_LDFLAGS := -L${TARGET_DIR}
+TGT_LDLIBS := -lgraph $(graph_ldlibs) $(boost_ldlibs)
+TGT_PREREQS := libgraph.a
+
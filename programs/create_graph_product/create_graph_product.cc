@@ -5,6 +5,7 @@
 #include <graph/graph.hh>
 #include <graph/product.hh>
 #include <graph/file_formats.hh>
+#include <graph/output_formats.hh>
 
 #include <iostream>
 #include <exception>
@@ -21,6 +22,7 @@ auto main(int argc, char * argv[]) -> int
         display_options.add_options()
             ("help",                                         "Display help information")
             ("format",             po::value<std::string>(), "Specify the format of the input")
+            ("output-format",      po::value<std::string>(), "Specify the format of the output (default dimacs)")
             ;
 
         po::options_description all_options{ "All options" };
@@ -75,6 +77,22 @@ auto main(int argc, char * argv[]) -> int
             return EXIT_FAILURE;
         }
 
+        /* Turn an output format name into a runnable function. */
+        auto output_format = graph_writers.begin(), output_format_end = graph_writers.end();
+        if (options_vars.count("output-format"))
+            for ( ; output_format != output_format_end ; ++output_format)
+                if (output_format->first == options_vars["output-format"].as<std::string>())
+                    break;
+
+        /* Unknown output format? Show a message and exit. */
+        if (output_format == output_format_end) {
+            std::cerr << "Unknown output format " << options_vars["output-format"].as<std::string>() << ", choose from:";
+            for (auto a : graph_writers)
+                std::cerr << " " << a.first;
+            std::cerr << std::endl;
+            return EXIT_FAILURE;
+        }
+
         /* Read in the graphs */
         auto graph1 = std::get<1>(*format)(options_vars["graph1"].as<std::string>(), GraphOptions::AllowLoops);
         auto graph2 = std::get<1>(*format)(options_vars["graph2"].as<std::string>(), GraphOptions::AllowLoops);
@@ -83,13 +101,7 @@ auto main(int argc, char * argv[]) -> int
            noninduced_modular_product(graph1, graph2) :
            modular_product(graph1, graph2);
 
-        std::cout << "p edge " << product.size() << " 0" << std::endl;
-        for (int e = 0 ; e < product.size() ; ++e) {
-            for (int f = e + 1 ; f < product.size() ; ++f) {
-                if (product.adjacent(e, f))
-                    std::cout << "e " << (e + 1) << " " << (f + 1) << std::endl;
-            }
-        }
+        std::get<1>(*output_format)(std::cout, product);
 
         return EXIT_SUCCESS;
     }
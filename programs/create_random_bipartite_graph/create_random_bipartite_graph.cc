@@ -1,13 +1,17 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
+#include <graph/graph.hh>
+#include <graph/graph_writer.hh>
+#include <graph/random_graph.hh>
+
 #include <boost/program_options.hpp>
 
 #include <iostream>
 #include <exception>
 #include <cstdlib>
 #include <set>
-#include <random>
 
+using namespace parasols;
 namespace po = boost::program_options;
 
 auto main(int argc, char * argv[]) -> int
@@ -62,17 +66,8 @@ auto main(int argc, char * argv[]) -> int
         double p = options_vars["p"].as<double>();
         int s = options_vars["s"].as<int>();
 
-        std::mt19937 rand;
-        rand.seed(s);
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-
-        std::cout << "p edge " << n1 + n2 << " 0" << std::endl;
-        for (int e = 1 ; e <= n1 ; ++e) {
-            for (int f = n1 + 1 ; f <= n1 + n2 ; ++f) {
-                if (dist(rand) <= p)
-                    std::cout << "e " << e << " " << f << std::endl;
-            }
-        }
+        auto graph = random_bipartite_graph(n1, n2, p, s, true);
+        write_dimacs(std::cout, graph);
 
         return EXIT_SUCCESS;
     }
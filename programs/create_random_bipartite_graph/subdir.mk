@@ -2,4 +2,6 @@ TARGET := create_random_bipartite_graph
 
 SOURCES := create_random_bipartite_graph.cc
 
-TGT_LDLIBS := $(boost_ldlibs) -lrt
+TGT_LDFLAGS := -L${TARGET_DIR}
+TGT_LDLIBS := -lgraph $(graph_ldlibs) $(boost_ldlibs) -lrt
+TGT_PREREQS := libgraph.a
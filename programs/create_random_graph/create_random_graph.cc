@@ -1,5 +1,9 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
+#include <graph/graph.hh>
+#include <graph/output_formats.hh>
+#include <graph/random_graph.hh>
+
 #include <boost/program_options.hpp>
 
 #include <iostream>
@@ -8,8 +12,8 @@
 #include <algorithm>
 #include <cstdlib>
 #include <set>
-#include <random>
 
+using namespace parasols;
 namespace po = boost::program_options;
 
 auto main(int argc, char * argv[]) -> int
@@ -62,54 +66,25 @@ auto main(int argc, char * argv[]) -> int
         double p = options_vars["p"].as<double>();
         int s = options_vars["s"].as<int>();
 
-        std::mt19937 rand;
-        rand.seed(s);
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-
-        std::function<void (int, int)> output_function;
-
-        if (! options_vars.count("format") || options_vars["format"].as<std::string>() == "dimacs") {
-            std::cout << "p edge " << n << " 0" << std::endl;
-            output_function = [] (int e, int f) { std::cout << "e " << e << " " << f << std::endl; };
-        }
-        else if (options_vars["format"].as<std::string>() == "pairs0") {
-            std::cout << n << " 0" << std::endl;
-            output_function = [] (int e, int f) { std::cout << e - 1 << " " << f - 1 << std::endl; };
-        }
-        else if (options_vars["format"].as<std::string>() == "lad") {
-            std::cout << n << std::endl;
-        }
-        else {
-            std::cout << "Unknown format (try 'dimacs' or 'pairs0')" << std::endl;
+        /* Turn a format name into a runnable function. */
+        auto format = graph_writers.begin(), format_end = graph_writers.end();
+        if (options_vars.count("format"))
+            for ( ; format != format_end ; ++format)
+                if (format->first == options_vars["format"].as<std::string>())
+                    break;
+
+        /* Unknown format? Show a message and exit. */
+        if (format == format_end) {
+            std::cerr << "Unknown format " << options_vars["format"].as<std::string>() << ", choose from:";
+            for (auto a : graph_writers)
+                std::cerr << " " << a.first;
+            std::cerr << std::endl;
             return EXIT_FAILURE;
         }
 
-        if (options_vars.count("format") && options_vars["format"].as<std::string>() == "lad") {
-            std::vector<std::vector<int> > adj = std::vector<std::vector<int> >(n, std::vector<int>(n, 0));
-
-            for (int e = 0 ; e < n ; ++e)
-                for (int f = e + 1 ; f < n ; ++f)
-                    if (dist(rand) <= p)
-                        adj[e][f] = adj[f][e] = 1;
-
-            for (int e = 0 ; e < n ; ++e) {
-                int k = std::count(adj[e].begin(), adj[e].end(), 1);
-                std::cout << k;
-                for (int f = 0 ; f < n ; ++f) {
-                    if (adj[e][f])
-                        std::cout << " " << f;
-                }
-                std::cout << std::endl;
-            }
-        }
-        else {
-            for (int e = 1 ; e <= n ; ++e) {
-                for (int f = e + 1 ; f <= n ; ++f) {
-                    if (dist(rand) <= p)
-                        output_function(e, f);
-                }
-            }
-        }
+        auto graph = random_graph(n, p, s, true);
+
+        std::get<1>(*format)(std::cout, graph);
 
         return EXIT_SUCCESS;
     }
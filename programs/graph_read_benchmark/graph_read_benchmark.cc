@@ -0,0 +1,239 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <graph/graph.hh>
+#include <graph/file_formats.hh>
+#include <graph/graph_file_error.hh>
+#include <graph/tokeniser.hh>
+
+#include <boost/program_options.hpp>
+#include <boost/regex.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <exception>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+using namespace parasols;
+namespace po = boost::program_options;
+
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+
+namespace
+{
+    /**
+     * The line-at-a-time regex DIMACS reader we used to have, kept here so we
+     * have something to compare against.
+     */
+    auto read_dimacs_regex(const std::string & filename, const GraphOptions & options) -> Graph
+    {
+        Graph result(0, true);
+
+        std::ifstream infile{ filename };
+        if (! infile)
+            throw GraphFileError{ filename, "unable to open file" };
+
+        std::string line;
+        while (std::getline(infile, line)) {
+            if (line.empty())
+                continue;
+
+            static const boost::regex
+                comment{ R"(c(\s.*)?)" },
+                problem{ R"(p\s+(edge|col)\s+(\d+)\s+(\d+)?\s*)" },
+                edge{ R"(e\s+(\d+)\s+(\d+)\s*)" };
+
+            boost::smatch match;
+            if (regex_match(line, match, comment)) {
+            }
+            else if (regex_match(line, match, problem)) {
+                if (0 != result.size())
+                    throw GraphFileError{ filename, "multiple 'p' lines encountered" };
+                result.resize(std::stoi(match.str(2)));
+            }
+            else if (regex_match(line, match, edge)) {
+                int a{ std::stoi(match.str(1)) }, b{ std::stoi(match.str(2)) };
+                if (0 == a || 0 == b || a > result.size() || b > result.size())
+                    throw GraphFileError{ filename, "line '" + line + "' edge index out of bounds" };
+                else if (a == b && ! test(options, GraphOptions::AllowLoops))
+                    throw GraphFileError{ filename, "line '" + line + "' contains a loop on vertex " + std::to_string(a) };
+                result.add_edge(a - 1, b - 1);
+            }
+            else
+                throw GraphFileError{ filename, "cannot parse line '" + line + "'" };
+        }
+
+        if (! infile.eof())
+            throw GraphFileError{ filename, "error reading file" };
+
+        return result;
+    }
+
+    auto same_graph(const Graph & a, const Graph & b) -> bool
+    {
+        if (a.size() != b.size())
+            return false;
+
+        for (int v = 0 ; v < a.size() ; ++v)
+            if (0 != std::memcmp(a.neighbourhood_words(v), b.neighbourhood_words(v), a.words_per_row() * sizeof(BitWord)))
+                return false;
+
+        return true;
+    }
+
+    auto count_edges(const Graph & graph) -> unsigned long long
+    {
+        unsigned long long degrees = 0, loops = 0;
+        for (int v = 0 ; v < graph.size() ; ++v) {
+            degrees += graph.degree(v);
+            if (graph.adjacent(v, v))
+                ++loops;
+        }
+
+        return (degrees + loops) / 2;
+    }
+
+    /**
+     * Run a reader some number of times, and return the best time in
+     * seconds, along with the graph it read.
+     */
+    template <typename Reader_>
+    auto time_reader(const Reader_ & reader, const std::string & filename, int repeat, Graph & graph) -> double
+    {
+        double best = 0.0;
+        for (int r = 0 ; r < repeat ; ++r) {
+            auto start_time = steady_clock::now();
+            graph = reader(filename, GraphOptions::AllowLoops);
+            double seconds = duration_cast<microseconds>(steady_clock::now() - start_time).count() / 1e6;
+            if (0 == r || seconds < best)
+                best = seconds;
+        }
+
+        return best;
+    }
+}
+
+auto main(int argc, char * argv[]) -> int
+{
+    try {
+        po::options_description display_options{ "Program options" };
+        display_options.add_options()
+            ("help",                                 "Display help information")
+            ("repeat",             po::value<int>(), "Read each file this many times, and report the best (default 3)")
+            ("format",             po::value<std::string>(), "Specify the format of the input")
+            ("threads",            po::value<unsigned>(), "Number of threads to use when parsing (default one per hardware thread)")
+            ("compare-regex",                        "Also time the old regex DIMACS reader, and check it gives the same graph")
+            ;
+
+        po::options_description all_options{ "All options" };
+        all_options.add_options()
+            ("input-file", po::value<std::vector<std::string> >(),
+                           "Specify an input file (DIMACS format, unless --format is specified). May be specified multiple times.")
+            ;
+
+        all_options.add(display_options);
+
+        po::positional_options_description positional_options;
+        positional_options
+            .add("input-file", -1)
+            ;
+
+        po::variables_map options_vars;
+        po::store(po::command_line_parser(argc, argv)
+                .options(all_options)
+                .positional(positional_options)
+                .run(), options_vars);
+        po::notify(options_vars);
+
+        /* --help? Show a message, and exit. */
+        if (options_vars.count("help")) {
+            std::cout << "Usage: " << argv[0] << " [options] file[...]" << std::endl;
+            std::cout << std::endl;
+            std::cout << display_options << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        /* No input file specified? Show a message and exit. */
+        if (options_vars.count("input-file") < 1) {
+            std::cout << "Usage: " << argv[0] << " [options] file[...]" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        int repeat = options_vars.count("repeat") ? options_vars["repeat"].as<int>() : 3;
+
+        if (options_vars.count("threads"))
+            set_text_parse_threads(options_vars["threads"].as<unsigned>());
+
+        /* Turn a format name into a runnable function. */
+        auto format = graph_file_formats.begin(), format_end = graph_file_formats.end();
+        if (options_vars.count("format"))
+            for ( ; format != format_end ; ++format)
+                if (format->first == options_vars["format"].as<std::string>())
+                    break;
+
+        /* Unknown format? Show a message and exit. */
+        if (format == format_end) {
+            std::cerr << "Unknown format " << options_vars["format"].as<std::string>() << ", choose from:";
+            for (auto a : graph_file_formats)
+                std::cerr << " " << a.first;
+            std::cerr << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        bool compare_regex = options_vars.count("compare-regex");
+        if (compare_regex && format->first != "dimacs") {
+            std::cerr << "Error: --compare-regex only works with the dimacs format" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "# file format bytes vertices edges seconds MB/s edges/s";
+        if (compare_regex)
+            std::cout << " regex_seconds regex_MB/s regex_edges/s speedup";
+        std::cout << std::endl;
+
+        for (auto & input_file : options_vars["input-file"].as<std::vector<std::string> >()) {
+            std::ifstream infile{ input_file, std::ios::binary | std::ios::ate };
+            if (! infile)
+                throw GraphFileError{ input_file, "unable to open file" };
+            double megabytes = infile.tellg() / 1e6;
+
+            Graph graph;
+            double time = time_reader(std::get<1>(*format), input_file, repeat, graph);
+            unsigned long long edges = count_edges(graph);
+
+            std::cout << input_file << " " << format->first << " " << std::size_t(megabytes * 1e6) << " "
+                << graph.size() << " " << edges << " "
+                << time << " " << (megabytes / time) << " " << (edges / time);
+
+            if (compare_regex) {
+                Graph old_graph;
+                double old_time = time_reader(read_dimacs_regex, input_file, repeat, old_graph);
+
+                if (! same_graph(old_graph, graph)) {
+                    std::cout << std::endl;
+                    std::cerr << "Error: readers disagree on " << input_file << std::endl;
+                    return EXIT_FAILURE;
+                }
+
+                std::cout << " " << old_time << " " << (megabytes / old_time) << " " << (edges / old_time)
+                    << " " << (old_time / time);
+            }
+
+            std::cout << std::endl;
+        }
+
+        return EXIT_SUCCESS;
+    }
+    catch (const po::error & e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << "Try " << argv[0] << " --help" << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch (const std::exception & e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,8 @@
+TARGET := graph_read_benchmark
+
+SOURCES := graph_read_benchmark.cc
+
+TGT_LDFLAGS := -L${TARGET_DIR}
+TGT_LDLIBS := -lgraph $(graph_ldlibs) $(boost_ldlibs)
+TGT_PREREQS := libgraph.a
+
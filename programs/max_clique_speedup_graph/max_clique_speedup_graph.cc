@@ -5,6 +5,7 @@
 #include <max_clique/algorithms.hh>
 
 #include <graph/degree_sort.hh>
+#include <graph/random_graph.hh>
 #include <graph/orders.hh>
 
 #include <boost/program_options.hpp>
@@ -13,7 +14,7 @@
 #include <iomanip>
 #include <exception>
 #include <algorithm>
-#include <random>
+#include <cstdint>
 #include <thread>
 #include <cstdlib>
 
@@ -24,7 +25,7 @@ using std::chrono::steady_clock;
 using std::chrono::duration_cast;
 using std::chrono::milliseconds;
 
-std::mt19937 rnd;
+std::uint64_t next_seed = 0;
 
 void table(
         int size,
@@ -45,13 +46,7 @@ void table(
         std::vector<double> prove_nodes_average((algorithms.size()));
 
         for (int n = 0 ; n < samples ; ++n) {
-            Graph graph(size, false);
-
-            std::uniform_real_distribution<double> dist(0.0, 1.0);
-            for (int e = 0 ; e < size ; ++e)
-                for (int f = e + 1 ; f < size ; ++f)
-                    if (dist(rnd) <= (double(p) / 100.0))
-                        graph.add_edge(e, f);
+            auto graph = random_graph(size, double(p) / 100.0, next_seed++, false);
 
             for (unsigned a = 0 ; a < algorithms.size() ; ++a) {
                 unsigned omega;
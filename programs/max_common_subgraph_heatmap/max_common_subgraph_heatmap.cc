@@ -5,6 +5,7 @@
 
 #include <graph/orders.hh>
 #include <graph/product.hh>
+#include <graph/random_graph.hh>
 
 #include <boost/program_options.hpp>
 
@@ -12,7 +13,6 @@
 #include <iomanip>
 #include <exception>
 #include <algorithm>
-#include <random>
 #include <thread>
 #include <cstdlib>
 
@@ -39,21 +39,8 @@ void table(int size1, int size2, int samples,
                    initial_colour_gap_total = 0.0;
 
             for (int sample = 0 ; sample < samples ; ++sample) {
-                std::mt19937 rnd1, rnd2;
-                rnd1.seed(1234 + sample + (p1 * 2 * samples));
-                rnd2.seed(24681012 + sample + samples + (p2 * 2 * samples));
-                Graph graph1(size1, false), graph2(size2, false);
-
-                std::uniform_real_distribution<double> dist(0.0, 1.0);
-                for (int e = 0 ; e < size1 ; ++e)
-                    for (int f = e + 1 ; f < size1 ; ++f)
-                        if (dist(rnd1) <= (double(p1) / 100.0))
-                            graph1.add_edge(e, f);
-
-                for (int e = 0 ; e < size2 ; ++e)
-                    for (int f = e + 1 ; f < size2 ; ++f)
-                        if (dist(rnd2) <= (double(p2) / 100.0))
-                            graph2.add_edge(e, f);
+                auto graph1 = random_graph(size1, double(p1) / 100.0, 1234 + sample + (p1 * 2 * samples), false);
+                auto graph2 = random_graph(size2, double(p2) / 100.0, 24681012 + sample + samples + (p2 * 2 * samples), false);
 
                 MaxCommonSubgraphParams params;
                 params.max_clique_algorithm = algorithm;
@@ -3,7 +3,7 @@ TARGET := merge_cliques
 SOURCES := merge_cliques.cc
 
 TGT_LDFLAGS := -L${TARGET_DIR}
-TGT_LDLIBS := -lgraph $(boost_ldlibs)
+TGT_LDLIBS := -lgraph $(graph_ldlibs) $(boost_ldlibs)
 TGT_PREREQS := libgraph.a
 
 
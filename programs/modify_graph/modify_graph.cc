@@ -2,6 +2,7 @@
 
 #include <graph/graph.hh>
 #include <graph/file_formats.hh>
+#include <graph/output_formats.hh>
 #include <graph/power.hh>
 #include <graph/complement.hh>
 #include <graph/add_dominated_vertices.hh>
@@ -29,6 +30,7 @@ auto main(int argc, char * argv[]) -> int
             ("join-dominated",     po::value<double>(), "When adding dominated vertices, join dominated vertices with this probability")
             ("dominated-seed",     po::value<int>(), "Seed for adding dominated vertices")
             ("format",             po::value<std::string>(), "Specify the format of the input")
+            ("output-format",      po::value<std::string>(), "Specify the format of the output (default dimacs)")
             ;
 
         po::options_description all_options{ "All options" };
@@ -80,6 +82,22 @@ auto main(int argc, char * argv[]) -> int
             return EXIT_FAILURE;
         }
 
+        /* Turn an output format name into a runnable function. */
+        auto output_format = graph_writers.begin(), output_format_end = graph_writers.end();
+        if (options_vars.count("output-format"))
+            for ( ; output_format != output_format_end ; ++output_format)
+                if (output_format->first == options_vars["output-format"].as<std::string>())
+                    break;
+
+        /* Unknown output format? Show a message and exit. */
+        if (output_format == output_format_end) {
+            std::cerr << "Unknown output format " << options_vars["output-format"].as<std::string>() << ", choose from:";
+            for (auto a : graph_writers)
+                std::cerr << " " << a.first;
+            std::cerr << std::endl;
+            return EXIT_FAILURE;
+        }
+
         /* Read in the graph */
         auto graph = std::get<1>(*format)(options_vars["input-file"].as<std::string>(), GraphOptions::None);
 
@@ -106,11 +124,7 @@ auto main(int argc, char * argv[]) -> int
         if (0 != dominated_vertices)
             graph = add_dominated_vertices(graph, dominated_vertices, dominated_edge_p, dominated_join_p, dominated_seed);
 
-        std::cout << "p edge " << graph.size() << " 0" << std::endl;
-        for (int e = 1 ; e <= graph.size() ; ++e)
-            for (int f = e + 1 ; f <= graph.size() ; ++f)
-                if (graph.adjacent(e - 1, f - 1))
-                    std::cout << "e " << e << " " << f << std::endl;
+        std::get<1>(*output_format)(std::cout, graph);
 
         return EXIT_SUCCESS;
     }
@@ -1,10 +1,13 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 #include <solver/solver.hh>
+#include <solver/result_cache.hh>
 
 #include <graph/graph.hh>
+#include <graph/bit_graph.hh>
 #include <graph/file_formats.hh>
 #include <graph/orders.hh>
+#include <graph/fingerprint.hh>
 
 #include <max_biclique/algorithms.hh>
 
@@ -15,6 +18,8 @@
 #include <cstdlib>
 #include <chrono>
 #include <thread>
+#include <memory>
+#include <sstream>
 
 using namespace parasols;
 namespace po = boost::program_options;
@@ -23,6 +28,68 @@ using std::chrono::steady_clock;
 using std::chrono::duration_cast;
 using std::chrono::milliseconds;
 
+namespace
+{
+    /**
+     * How we keep a result in a ResultCache.
+     */
+    auto result_to_lines(const MaxBicliqueResult & result) -> std::vector<std::string>
+    {
+        std::vector<std::string> lines{ std::to_string(result.size) + " " + std::to_string(result.nodes) };
+        for (auto & s : { result.members_a, result.members_b }) {
+            lines.emplace_back();
+            for (auto v : s)
+                lines.back() += std::to_string(v) + " ";
+        }
+
+        return lines;
+    }
+
+    auto result_from_lines(const std::vector<std::string> & lines, MaxBicliqueResult & result) -> bool
+    {
+        if (3 != lines.size())
+            return false;
+
+        std::istringstream counts{ lines[0] };
+        if (! (counts >> result.size >> result.nodes))
+            return false;
+
+        for (auto & m : { std::make_pair(1, &result.members_a), std::make_pair(2, &result.members_b) }) {
+            std::istringstream members{ lines[m.first] };
+            int v;
+            while (members >> v)
+                m.second->insert(v);
+
+            if (! members.eof())
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Is this really a biclique? We check this before storing a result in
+     * the cache, and after looking it up.
+     */
+    auto is_valid_result(const Graph & graph, const MaxBicliqueResult & result) -> bool
+    {
+        if (result.members_a.size() > result.size || result.members_b.size() > result.size)
+            return false;
+
+        for (auto & s : { result.members_a, result.members_b })
+            for (auto v : s)
+                if (v < 0 || v >= graph.size())
+                    return false;
+
+        for (auto & a : result.members_a)
+            for (auto & b : result.members_b)
+                if (a == b || ! graph.adjacent(a, b))
+                    return false;
+
+        return true;
+    }
+}
+
 auto main(int argc, char * argv[]) -> int
 {
     try {
@@ -36,6 +103,9 @@ auto main(int argc, char * argv[]) -> int
             ("timeout",            po::value<int>(),  "Abort after this many seconds")
             ("verify",                                "Verify that we have found a valid result (for sanity checking changes)")
             ("format",             po::value<std::string>(), "Specify the format of the input")
+            ("memory-budget",      po::value<int>(), "Refuse to build bit graphs needing more than this many megabytes")
+            ("cache",              po::value<std::string>(), "Look up results in, and store verified results in, this directory")
+            ("cache-stats",                           "Print result cache statistics to stderr at the end")
             ;
 
         po::options_description all_options{ "All options" };
@@ -141,16 +211,52 @@ auto main(int argc, char * argv[]) -> int
             return EXIT_FAILURE;
         }
 
+        /* Limit how big a bit graph we may build */
+        if (options_vars.count("memory-budget"))
+            set_bit_graph_memory_budget((unsigned long long) options_vars["memory-budget"].as<int>() << 20);
+
         /* Read in the graph */
         auto graph = std::get<1>(*format)(options_vars["input-file"].as<std::string>(), GraphOptions::None);
 
+        /* Have we solved this before? Everything that can change the result
+         * goes in the cache key. */
+        std::unique_ptr<ResultCache> cache;
+        std::string cache_key;
+        bool aborted = false, cached = false;
+        MaxBicliqueResult result;
+        if (options_vars.count("cache")) {
+            cache.reset(new ResultCache{ options_vars["cache"].as<std::string>() });
+
+            std::ostringstream key;
+            key << "max_biclique " << fingerprint(graph)
+                << " " << algorithm->first << " " << options_vars["order"].as<std::string>()
+                << " initial-bound=" << params.initial_bound
+                << " stop-after-finding=" << params.stop_after_finding;
+            cache_key = key.str();
+
+            params.start_time = steady_clock::now();
+            std::vector<std::string> cache_lines;
+            if (cache->lookup(cache_key, cache_lines)) {
+                if (result_from_lines(cache_lines, result) && is_valid_result(graph, result))
+                    cached = true;
+                else {
+                    cache->reject();
+                    result = MaxBicliqueResult{ };
+                }
+            }
+        }
+
         /* Do the actual run. */
-        bool aborted = false;
-        auto result = run_this(algorithm->second)(
-                graph,
-                params,
-                aborted,
-                options_vars.count("timeout") ? options_vars["timeout"].as<int>() : 0);
+        if (! cached) {
+            result = run_this(algorithm->second)(
+                    graph,
+                    params,
+                    aborted,
+                    options_vars.count("timeout") ? options_vars["timeout"].as<int>() : 0);
+
+            if (cache && ! aborted && is_valid_result(graph, result))
+                cache->store(cache_key, result_to_lines(result));
+        }
 
         /* Stop the clock. */
         auto overall_time = duration_cast<milliseconds>(steady_clock::now() - params.start_time);
@@ -183,6 +289,9 @@ auto main(int argc, char * argv[]) -> int
                     }
         }
 
+        if (cache && options_vars.count("cache-stats"))
+            cache->write_stats(std::cerr);
+
         return EXIT_SUCCESS;
     }
     catch (const po::error & e) {
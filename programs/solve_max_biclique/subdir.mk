@@ -3,6 +3,6 @@ TARGET := solve_max_biclique
 SOURCES := solve_max_biclique.cc
 
 TGT_LDFLAGS := -L${TARGET_DIR}
-TGT_LDLIBS := -lsolver -lmax_biclique -lthreads -lgraph $(boost_ldlibs)
+TGT_LDLIBS := -lsolver -lmax_biclique -lthreads -lgraph $(graph_ldlibs) $(boost_ldlibs)
 TGT_PREREQS := libmax_biclique.a libgraph.a libthreads.a libsolver.a
 
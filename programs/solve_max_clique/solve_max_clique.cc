@@ -1,17 +1,24 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 #include <solver/solver.hh>
+#include <solver/result_cache.hh>
 
 #include <graph/graph.hh>
+#include <graph/bit_graph.hh>
 #include <graph/file_formats.hh>
 #include <graph/power.hh>
 #include <graph/complement.hh>
 #include <graph/is_clique.hh>
+#include <graph/is_independent_set.hh>
 #include <graph/is_club.hh>
 #include <graph/orders.hh>
 #include <graph/add_dominated_vertices.hh>
+#include <graph/fingerprint.hh>
 
 #include <max_clique/algorithms.hh>
+#include <max_clique/kernelise.hh>
+
+#include <threads/prefetcher.hh>
 
 #include <boost/program_options.hpp>
 #include <boost/algorithm/string.hpp>
@@ -21,6 +28,9 @@
 #include <cstdlib>
 #include <chrono>
 #include <thread>
+#include <numeric>
+#include <memory>
+#include <sstream>
 
 using namespace parasols;
 namespace po = boost::program_options;
@@ -31,11 +41,102 @@ using std::chrono::milliseconds;
 
 namespace
 {
+    /**
+     * An input file, read in and ready to solve. If it was prefetched, we
+     * may also have worked out its initial vertex order already. If we are
+     * using a result cache, we also have its fingerprint.
+     */
+    struct Instance
+    {
+        Graph graph;
+        std::vector<int> order;
+        std::string fingerprint;
+    };
+
+    /**
+     * How we keep a result in a ResultCache.
+     */
+    auto result_to_lines(const MaxCliqueResult & result) -> std::vector<std::string>
+    {
+        std::string members;
+        for (auto v : result.members)
+            members += std::to_string(v) + " ";
+
+        return { std::to_string(result.size) + " " + std::to_string(result.nodes) + " " +
+            std::to_string(result.result_count) + " " + std::to_string(result.result_club_count), members };
+    }
+
+    auto result_from_lines(const std::vector<std::string> & lines, MaxCliqueResult & result) -> bool
+    {
+        if (2 != lines.size())
+            return false;
+
+        std::istringstream counts{ lines[0] }, members{ lines[1] };
+        if (! (counts >> result.size >> result.nodes >> result.result_count >> result.result_club_count))
+            return false;
+
+        int v;
+        while (members >> v)
+            result.members.insert(v);
+
+        return members.eof();
+    }
+
+    /**
+     * Is this really a clique, in the graph raised to the given power, or an
+     * independent set if that's what we were looking for? We check this
+     * before storing a result in the cache, and after looking it up.
+     */
+    auto is_valid_result(const Graph & graph, unsigned graph_power, bool independent_set, const MaxCliqueResult & result) -> bool
+    {
+        if (result.members.size() > result.size)
+            return false;
+
+        for (auto v : result.members)
+            if (v < 0 || v >= graph.size())
+                return false;
+
+        if (independent_set)
+            return is_independent_set(graph, result.members);
+        else if (graph_power > 1)
+            return is_clique(power(graph, graph_power), result.members);
+        else
+            return is_clique(graph, result.members);
+    }
+
+    /**
+     * Run func on a kernel of graph, and map its result back. The time taken
+     * to find the kernel goes at the start of the result's times.
+     */
+    auto run_on_kernel(MaxCliqueResult func(const Graph &, const MaxCliqueParams &),
+            const Graph & graph, const MaxCliqueParams & params) -> MaxCliqueResult
+    {
+        auto kernel_start_time = steady_clock::now();
+        auto kernel = kernelise_max_clique(graph, params.initial_bound);
+        auto kernel_time = duration_cast<milliseconds>(steady_clock::now() - kernel_start_time);
+
+        /* We only need to look for something better than what
+         * kernelisation found. */
+        MaxCliqueParams kernel_params = params;
+        kernel_params.initial_bound = std::max<unsigned>(params.initial_bound, kernel.incumbent.size());
+
+        auto result = func(kernel.graph, kernel_params);
+
+        std::set<int> members;
+        for (auto v : result.members)
+            members.insert(kernel.vertices[v]);
+        result.members = members.size() >= kernel.incumbent.size() ? members : kernel.incumbent;
+
+        result.times.insert(result.times.begin(), kernel_time);
+        return result;
+    }
+
     auto run_with_modifications(MaxCliqueResult func(const Graph &, const MaxCliqueParams &),
                 unsigned dominated_vertices,
                 double dominated_edge_p,
                 double dominated_join_p,
-                unsigned dominated_seed
+                unsigned dominated_seed,
+                bool kernelise
             ) ->
         std::function<MaxCliqueResult (
                 const Graph &,
@@ -53,10 +154,12 @@ namespace
                         auto power_start_time = steady_clock::now();
                         auto power_graph = power(modified_graph, params.power);
                         auto power_time = duration_cast<milliseconds>(steady_clock::now() - power_start_time);
-                        auto result = func(power_graph, params);
+                        auto result = kernelise ? run_on_kernel(func, power_graph, params) : func(power_graph, params);
                         result.times.insert(result.times.begin(), power_time);
                         return result;
                     }
+                    else if (kernelise)
+                        return run_on_kernel(func, modified_graph, params);
                     else
                         return func(modified_graph, params);
                 });
@@ -78,8 +181,11 @@ auto main(int argc, char * argv[]) -> int
             ("work-donation",                        "Enable work donation (where relevant)")
             ("timeout",            po::value<int>(), "Abort after this many seconds")
             ("complement",                           "Take the complement of the graph (to solve independent set)")
+            ("independent-set",                      "Solve independent set directly, without taking the complement (algorithm "
+                                                     "must be one of ccon ccod tccon tccod, and order is applied to the graph as given)")
             ("power",              po::value<int>(), "Raise the graph to this power (to solve s-clique)")
             ("vertex-transitive",                    "Specify if the graph is known to be vertex transitive")
+            ("kernelise",                            "Shrink the graph using a greedy incumbent, k-core peeling and dominance first")
             ("add-dominated",      po::value<int>(), "Add this many dominated vertices to the input graph")
             ("dominated-edges",    po::value<double>(), "When adding dominated vertices, keep edges with this probability")
             ("join-dominated",     po::value<double>(), "When adding dominated vertices, join dominated vertices with this probability")
@@ -87,6 +193,11 @@ auto main(int argc, char * argv[]) -> int
             ("verify",                               "Verify that we have found a valid result (for sanity checking changes)")
             ("check-club",                           "Check whether our s-clique is also an s-club")
             ("format",             po::value<std::string>(), "Specify the format of the input")
+            ("memory-budget",      po::value<int>(), "Refuse to build bit graphs needing more than this many megabytes")
+            ("prefetch",           po::value<int>(), "Read and order up to this many input files ahead of the one being solved, "
+                                                     "in another thread (ordering is then not timed)")
+            ("cache",              po::value<std::string>(), "Look up results in, and store verified results in, this directory")
+            ("cache-stats",                          "Print result cache statistics to stderr at the end")
             ;
 
         po::options_description all_options{ "All options" };
@@ -128,7 +239,9 @@ auto main(int argc, char * argv[]) -> int
         }
 
         /* Turn an algorithm string name into a runnable function. */
-        auto algorithm = max_clique_algorithms.begin(), algorithm_end = max_clique_algorithms.end();
+        bool independent_set = options_vars.count("independent-set");
+        auto & algorithms = independent_set ? max_independent_set_algorithms : max_clique_algorithms;
+        auto algorithm = algorithms.begin(), algorithm_end = algorithms.end();
         for ( ; algorithm != algorithm_end ; ++algorithm)
             if (std::get<0>(*algorithm) == options_vars["algorithm"].as<std::string>())
                 break;
@@ -136,7 +249,7 @@ auto main(int argc, char * argv[]) -> int
         /* Unknown algorithm? Show a message and exit. */
         if (algorithm == algorithm_end) {
             std::cerr << "Unknown algorithm " << options_vars["algorithm"].as<std::string>() << ", choose from:";
-            for (auto a : max_clique_algorithms)
+            for (auto a : algorithms)
                 std::cerr << " " << std::get<0>(a);
             std::cerr << std::endl;
             return EXIT_FAILURE;
@@ -159,19 +272,109 @@ auto main(int argc, char * argv[]) -> int
             return EXIT_FAILURE;
         }
 
-        /* For each input file... */
+        /* Kernelisation renumbers vertices, and doesn't keep every maximum
+         * clique. */
+        if (options_vars.count("kernelise") && (options_vars.count("enumerate") || options_vars.count("check-club")
+                    || options_vars.count("vertex-transitive"))) {
+            std::cerr << "Can't use --kernelise with --enumerate, --check-club or --vertex-transitive" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        /* Everything else that modifies the graph only makes sense for
+         * cliques. */
+        if (independent_set && (options_vars.count("complement") || options_vars.count("power")
+                    || options_vars.count("kernelise") || options_vars.count("add-dominated")
+                    || options_vars.count("check-club"))) {
+            std::cerr << "Can't use --independent-set with --complement, --power, --kernelise, --add-dominated or --check-club" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        /* Limit how big a bit graph we may build */
+        if (options_vars.count("memory-budget"))
+            set_bit_graph_memory_budget((unsigned long long) options_vars["memory-budget"].as<int>() << 20);
+
+        /* Turn a format name into a runnable function. */
+        auto format = graph_file_formats.begin(), format_end = graph_file_formats.end();
+        if (options_vars.count("format"))
+            for ( ; format != format_end ; ++format)
+                if (format->first == options_vars["format"].as<std::string>())
+                    break;
+
+        /* Unknown format? Show a message and exit. */
+        if (format == format_end) {
+            std::cerr << "Unknown format " << options_vars["format"].as<std::string>() << ", choose from:";
+            for (auto a : graph_file_formats)
+                std::cerr << " " << a.first;
+            std::cerr << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        unsigned dominated_vertices = 0;
+        double dominated_edge_p = 1.0;
+        double dominated_join_p = 0.0;
+        unsigned dominated_seed = 0;
+        if (options_vars.count("add-dominated"))
+            dominated_vertices = options_vars["add-dominated"].as<int>();
+        if (options_vars.count("dominated-edges"))
+            dominated_edge_p = options_vars["dominated-edges"].as<double>();
+        if (options_vars.count("join-dominated"))
+            dominated_join_p = options_vars["join-dominated"].as<double>();
+        if (options_vars.count("dominated-seed"))
+            dominated_seed = options_vars["dominated-seed"].as<int>();
+
+        unsigned prefetch = options_vars.count("prefetch") ? options_vars["prefetch"].as<int>() : 0;
+
+        /* Dominated vertices are made up afresh each time, so results
+         * involving them aren't worth keeping. */
+        std::unique_ptr<ResultCache> cache;
+        if (options_vars.count("cache") && 0 == dominated_vertices)
+            cache.reset(new ResultCache{ options_vars["cache"].as<std::string>() });
+
+        /* We can only order a graph in advance if the algorithm will be
+         * given that graph, and not a modified copy. */
+        bool order_in_advance = prefetch > 0 && 0 == dominated_vertices && ! options_vars.count("kernelise") &&
+            ! (options_vars.count("power") && options_vars["power"].as<int>() > 1);
+
+        /* Read each input file, possibly whilst the previous one is being
+         * solved. */
         auto input_files = options_vars["input-file"].as<std::vector<std::string> >();
-        bool first = true;
-        for (auto & input_file : input_files) {
-            if (first)
-                first = false;
-            else
+        Prefetcher<Instance> instances(input_files.size(), prefetch, [&] (unsigned i) -> Instance {
+                Instance instance{ std::get<1>(*format)(input_files[i], GraphOptions::None), { }, { } };
+
+                if (options_vars.count("complement"))
+                    instance.graph = complement(instance.graph); // don't time this
+
+                if (order_in_advance) {
+                    instance.order.resize(instance.graph.size());
+                    std::iota(instance.order.begin(), instance.order.end(), 0);
+                    order_function(instance.graph, instance.order);
+                }
+
+                if (cache)
+                    instance.fingerprint = fingerprint(instance.graph);
+
+                return instance;
+                });
+
+        /* For each input file... */
+        for (unsigned i = 0 ; i < input_files.size() ; ++i) {
+            if (0 != i)
                 std::cout << "--" << std::endl;
 
+            /* Read in the graph */
+            auto instance = instances.next();
+            auto & graph = instance.graph;
+
             /* Figure out what our options should be. */
             MaxCliqueParams params;
 
-            params.order_function = order_function;
+            /* If the graph has already been ordered, use that order. */
+            params.order_function = [&] (const Graph & g, std::vector<int> & order) {
+                if (&g == &graph && ! instance.order.empty())
+                    order = instance.order;
+                else
+                    order_function(g, order);
+            };
 
             if (options_vars.count("threads"))
                 params.n_threads = options_vars["threads"].as<int>();
@@ -205,53 +408,57 @@ auto main(int argc, char * argv[]) -> int
             if (options_vars.count("vertex-transitive"))
                 params.vertex_transitive = true;
 
-            unsigned dominated_vertices = 0;
-            double dominated_edge_p = 1.0;
-            double dominated_join_p = 0.0;
-            unsigned dominated_seed = 0;
-            if (options_vars.count("add-dominated"))
-                dominated_vertices = options_vars["add-dominated"].as<int>();
-            if (options_vars.count("dominated-edges"))
-                dominated_edge_p = options_vars["dominated-edges"].as<double>();
-            if (options_vars.count("join-dominated"))
-                dominated_join_p = options_vars["join-dominated"].as<double>();
-            if (options_vars.count("dominated-seed"))
-                dominated_seed = options_vars["dominated-seed"].as<int>();
-
-            /* Turn a format name into a runnable function. */
-            auto format = graph_file_formats.begin(), format_end = graph_file_formats.end();
-            if (options_vars.count("format"))
-                for ( ; format != format_end ; ++format)
-                    if (format->first == options_vars["format"].as<std::string>())
-                        break;
-
-            /* Unknown format? Show a message and exit. */
-            if (format == format_end) {
-                std::cerr << "Unknown format " << options_vars["format"].as<std::string>() << ", choose from:";
-                for (auto a : graph_file_formats)
-                    std::cerr << " " << a.first;
-                std::cerr << std::endl;
-                return EXIT_FAILURE;
-            }
+            if (options_vars.count("complement"))
+                params.complement = true;
 
-            /* Read in the graph */
-            auto graph = std::get<1>(*format)(input_file, GraphOptions::None);
+            params.original_graph = &graph;
 
-            if (options_vars.count("complement")) {
-                graph = complement(graph); // don't time this
-                params.complement = true;
+            /* Everything that can change the result goes in the cache key. */
+            std::string cache_key;
+            if (cache) {
+                std::ostringstream key;
+                key << "max_clique " << instance.fingerprint
+                    << " " << std::get<0>(*algorithm) << " " << options_vars["order"].as<std::string>()
+                    << " power=" << params.power
+                    << " initial-bound=" << params.initial_bound
+                    << " stop-after-finding=" << params.stop_after_finding
+                    << " enumerate=" << params.enumerate
+                    << " check-club=" << params.check_clubs
+                    << " vertex-transitive=" << params.vertex_transitive
+                    << " kernelise=" << options_vars.count("kernelise")
+                    << " independent-set=" << independent_set;
+                cache_key = key.str();
             }
 
-            params.original_graph = &graph;
+            /* Have we solved this before? */
+            bool aborted = false, cached = false;
+            MaxCliqueResult result;
+            std::vector<std::string> cache_lines;
+            if (cache) {
+                params.start_time = steady_clock::now();
+                if (cache->lookup(cache_key, cache_lines)) {
+                    if (result_from_lines(cache_lines, result) && is_valid_result(graph, params.power, independent_set, result))
+                        cached = true;
+                    else {
+                        cache->reject();
+                        result = MaxCliqueResult{ };
+                    }
+                }
+            }
 
             /* Do the actual run. */
-            bool aborted = false;
-            auto result = run_with_modifications(std::get<1>(*algorithm),
-                    dominated_vertices, dominated_edge_p, dominated_join_p, dominated_seed)(
-                        graph,
-                        params,
-                        aborted,
-                        options_vars.count("timeout") ? options_vars["timeout"].as<int>() : 0);
+            if (! cached) {
+                result = run_with_modifications(std::get<1>(*algorithm),
+                        dominated_vertices, dominated_edge_p, dominated_join_p, dominated_seed,
+                        options_vars.count("kernelise"))(
+                            graph,
+                            params,
+                            aborted,
+                            options_vars.count("timeout") ? options_vars["timeout"].as<int>() : 0);
+
+                if (cache && ! aborted && is_valid_result(graph, params.power, independent_set, result))
+                    cache->store(cache_key, result_to_lines(result));
+            }
 
             /* Stop the clock. */
             auto overall_time = duration_cast<milliseconds>(steady_clock::now() - params.start_time);
@@ -296,7 +503,13 @@ auto main(int argc, char * argv[]) -> int
                 std::cout << result.donations << std::endl;
 
             if (options_vars.count("verify")) {
-                if (params.power > 1) {
+                if (independent_set) {
+                    if (! is_independent_set(graph, result.members)) {
+                        std::cerr << "Oops! not an independent set" << std::endl;
+                        return EXIT_FAILURE;
+                    }
+                }
+                else if (params.power > 1) {
                     if (! is_clique(power(graph, params.power), result.members)) {
                         std::cerr << "Oops! not a clique" << std::endl;
                         return EXIT_FAILURE;
@@ -311,6 +524,9 @@ auto main(int argc, char * argv[]) -> int
             }
         }
 
+        if (cache && options_vars.count("cache-stats"))
+            cache->write_stats(std::cerr);
+
         return EXIT_SUCCESS;
     }
     catch (const po::error & e) {
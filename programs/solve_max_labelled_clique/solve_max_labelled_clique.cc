@@ -3,6 +3,7 @@
 #include <solver/solver.hh>
 
 #include <graph/graph.hh>
+#include <graph/bit_graph.hh>
 #include <graph/file_formats.hh>
 #include <graph/is_clique.hh>
 #include <graph/orders.hh>
@@ -10,6 +11,8 @@
 #include <max_labelled_clique/algorithms.hh>
 #include <max_labelled_clique/make_random_labels.hh>
 
+#include <threads/prefetcher.hh>
+
 #include <boost/program_options.hpp>
 #include <boost/algorithm/string.hpp>
 
@@ -18,6 +21,7 @@
 #include <cstdlib>
 #include <chrono>
 #include <thread>
+#include <numeric>
 
 using namespace parasols;
 namespace po = boost::program_options;
@@ -26,6 +30,20 @@ using std::chrono::steady_clock;
 using std::chrono::duration_cast;
 using std::chrono::milliseconds;
 
+namespace
+{
+    /**
+     * An input file, read in and labelled, and ready to solve. If it was
+     * prefetched, we will also have worked out its initial vertex order.
+     */
+    struct Instance
+    {
+        Graph graph;
+        Labels labels;
+        std::vector<int> order;
+    };
+}
+
 auto main(int argc, char * argv[]) -> int
 {
     try {
@@ -39,6 +57,9 @@ auto main(int argc, char * argv[]) -> int
             ("timeout",            po::value<int>(), "Abort after this many seconds")
             ("verify",                               "Verify that we have found a valid result (for sanity checking changes)")
             ("format",             po::value<std::string>(), "Specify the format of the input")
+            ("memory-budget",      po::value<int>(), "Refuse to build bit graphs needing more than this many megabytes")
+            ("prefetch",           po::value<int>(), "Read and order up to this many input files ahead of the one being solved, "
+                                                     "in another thread (ordering is then not timed)")
             ;
 
         po::options_description all_options{ "All options" };
@@ -118,19 +139,66 @@ auto main(int argc, char * argv[]) -> int
             return EXIT_FAILURE;
         }
 
-        /* For each input file... */
+        /* Limit how big a bit graph we may build */
+        if (options_vars.count("memory-budget"))
+            set_bit_graph_memory_budget((unsigned long long) options_vars["memory-budget"].as<int>() << 20);
+
+        /* Turn a format name into a runnable function. */
+        auto format = graph_file_formats.begin(), format_end = graph_file_formats.end();
+        if (options_vars.count("format"))
+            for ( ; format != format_end ; ++format)
+                if (format->first == options_vars["format"].as<std::string>())
+                    break;
+
+        /* Unknown format? Show a message and exit. */
+        if (format == format_end) {
+            std::cerr << "Unknown format " << options_vars["format"].as<std::string>() << ", choose from:";
+            for (auto a : graph_file_formats)
+                std::cerr << " " << a.first;
+            std::cerr << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        unsigned prefetch = options_vars.count("prefetch") ? options_vars["prefetch"].as<int>() : 0;
+
+        /* Read and label each input file, possibly whilst the previous one is
+         * being solved. */
         auto input_files = options_vars["input-file"].as<std::vector<std::string> >();
-        bool first = true;
-        for (auto & input_file : input_files) {
-            if (first)
-                first = false;
-            else
+        Prefetcher<Instance> instances(input_files.size(), prefetch, [&] (unsigned i) -> Instance {
+                Instance instance{ std::get<1>(*format)(input_files[i], GraphOptions::None), { }, { } };
+
+                /* Create labels */
+                instance.labels = make_random_labels(instance.graph.size(), options_vars["labels"].as<int>(),
+                        options_vars["seed"].as<int>());
+
+                if (prefetch > 0) {
+                    instance.order.resize(instance.graph.size());
+                    std::iota(instance.order.begin(), instance.order.end(), 0);
+                    order_function(instance.graph, instance.order);
+                }
+
+                return instance;
+                });
+
+        /* For each input file... */
+        for (unsigned i = 0 ; i < input_files.size() ; ++i) {
+            if (0 != i)
                 std::cout << "--" << std::endl;
 
+            /* Read in the graph */
+            auto instance = instances.next();
+            auto & graph = instance.graph;
+
             /* Figure out what our options should be. */
             MaxLabelledCliqueParams params;
 
-            params.order_function = order_function;
+            /* If the graph has already been ordered, use that order. */
+            params.order_function = [&] (const Graph & g, std::vector<int> & order) {
+                if (&g == &graph && ! instance.order.empty())
+                    order = instance.order;
+                else
+                    order_function(g, order);
+            };
             params.budget = options_vars["budget"].as<int>();
 
             if (options_vars.count("threads"))
@@ -147,28 +215,7 @@ auto main(int argc, char * argv[]) -> int
             if (options_vars.count("print-incumbents"))
                 params.print_incumbents = true;
 
-            /* Turn a format name into a runnable function. */
-            auto format = graph_file_formats.begin(), format_end = graph_file_formats.end();
-            if (options_vars.count("format"))
-                for ( ; format != format_end ; ++format)
-                    if (format->first == options_vars["format"].as<std::string>())
-                        break;
-
-            /* Unknown format? Show a message and exit. */
-            if (format == format_end) {
-                std::cerr << "Unknown format " << options_vars["format"].as<std::string>() << ", choose from:";
-                for (auto a : graph_file_formats)
-                    std::cerr << " " << a.first;
-                std::cerr << std::endl;
-                return EXIT_FAILURE;
-            }
-
-            /* Read in the graph */
-            auto graph = std::get<1>(*format)(input_file, GraphOptions::None);
-
-            /* Create labels */
-            params.labels = make_random_labels(graph.size(), options_vars["labels"].as<int>(),
-                    options_vars["seed"].as<int>());
+            params.labels = std::move(instance.labels);
 
             /* Do the actual run. */
             bool aborted = false;
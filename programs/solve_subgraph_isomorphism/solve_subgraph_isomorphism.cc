@@ -1,10 +1,13 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 #include <solver/solver.hh>
+#include <solver/result_cache.hh>
 
 #include <graph/graph.hh>
+#include <graph/bit_graph.hh>
 #include <graph/file_formats.hh>
 #include <graph/orders.hh>
+#include <graph/fingerprint.hh>
 
 #include <subgraph_isomorphism/algorithms.hh>
 
@@ -15,6 +18,9 @@
 #include <cstdlib>
 #include <chrono>
 #include <thread>
+#include <memory>
+#include <sstream>
+#include <set>
 
 using namespace parasols;
 namespace po = boost::program_options;
@@ -23,6 +29,66 @@ using std::chrono::steady_clock;
 using std::chrono::duration_cast;
 using std::chrono::milliseconds;
 
+namespace
+{
+    /**
+     * How we keep a result in a ResultCache.
+     */
+    auto result_to_lines(const SubgraphIsomorphismResult & result) -> std::vector<std::string>
+    {
+        std::vector<std::string> lines{ std::to_string(result.nodes), "" };
+        for (auto & v : result.isomorphism)
+            lines.back() += std::to_string(v.first) + " " + std::to_string(v.second) + " ";
+
+        return lines;
+    }
+
+    auto result_from_lines(const std::vector<std::string> & lines, SubgraphIsomorphismResult & result) -> bool
+    {
+        if (2 != lines.size())
+            return false;
+
+        std::istringstream counts{ lines[0] }, isomorphism{ lines[1] };
+        if (! (counts >> result.nodes))
+            return false;
+
+        int p, t;
+        while (isomorphism >> p >> t)
+            result.isomorphism.emplace(p, t);
+
+        return isomorphism.eof();
+    }
+
+    /**
+     * Is this really an isomorphism (or no isomorphism at all, which we can't
+     * check)? We check this before storing a result in the cache, and after
+     * looking it up.
+     */
+    auto is_valid_result(const std::pair<Graph, Graph> & graphs, bool induced, const SubgraphIsomorphismResult & result) -> bool
+    {
+        if (result.isomorphism.empty())
+            return true;
+
+        if (result.isomorphism.size() != unsigned(graphs.first.size()))
+            return false;
+
+        std::set<int> used;
+        for (auto & v : result.isomorphism)
+            if (v.first < 0 || v.first >= graphs.first.size() || v.second < 0 || v.second >= graphs.second.size()
+                    || ! used.insert(v.second).second)
+                return false;
+
+        for (auto & v : result.isomorphism)
+            for (auto & w : result.isomorphism)
+                if (graphs.first.adjacent(v.first, w.first) ?
+                        ! graphs.second.adjacent(v.second, w.second) :
+                        induced && graphs.second.adjacent(v.second, w.second))
+                    return false;
+
+        return true;
+    }
+}
+
 auto main(int argc, char * argv[]) -> int
 {
     try {
@@ -32,8 +98,11 @@ auto main(int argc, char * argv[]) -> int
             ("threads",            po::value<int>(),  "Number of threads to use (where relevant)")
             ("timeout",            po::value<int>(),  "Abort after this many seconds")
             ("format",             po::value<std::string>(), "Specify the format of the input")
+            ("memory-budget",      po::value<int>(), "Refuse to build bit graphs needing more than this many megabytes")
             ("verify",                                "Verify that we have found a valid result (for sanity checking changes)")
             ("induced",                               "Find induced isomorphisms")
+            ("cache",              po::value<std::string>(), "Look up results in, and store verified results in, this directory")
+            ("cache-stats",                           "Print result cache statistics to stderr at the end")
             ;
 
         po::options_description all_options{ "All options" };
@@ -114,18 +183,53 @@ auto main(int argc, char * argv[]) -> int
             return EXIT_FAILURE;
         }
 
+        /* Limit how big a bit graph we may build */
+        if (options_vars.count("memory-budget"))
+            set_bit_graph_memory_budget((unsigned long long) options_vars["memory-budget"].as<int>() << 20);
+
         /* Read in the graphs */
         auto graphs = std::make_pair(
             std::get<1>(*format)(options_vars["pattern-file"].as<std::string>(), GraphOptions::AllowLoops),
             std::get<1>(*format)(options_vars["target-file"].as<std::string>(), GraphOptions::AllowLoops));
 
+        /* Have we solved this before? Everything that can change the result
+         * goes in the cache key. */
+        std::unique_ptr<ResultCache> cache;
+        std::string cache_key;
+        bool aborted = false, cached = false;
+        SubgraphIsomorphismResult result;
+        if (options_vars.count("cache")) {
+            cache.reset(new ResultCache{ options_vars["cache"].as<std::string>() });
+
+            std::ostringstream key;
+            key << "subgraph_isomorphism " << fingerprint(graphs.first) << " " << fingerprint(graphs.second)
+                << " " << algorithm->first
+                << " induced=" << params.induced;
+            cache_key = key.str();
+
+            params.start_time = steady_clock::now();
+            std::vector<std::string> cache_lines;
+            if (cache->lookup(cache_key, cache_lines)) {
+                if (result_from_lines(cache_lines, result) && is_valid_result(graphs, params.induced, result))
+                    cached = true;
+                else {
+                    cache->reject();
+                    result = SubgraphIsomorphismResult{ };
+                }
+            }
+        }
+
         /* Do the actual run. */
-        bool aborted = false;
-        auto result = run_this(algorithm->second)(
-                graphs,
-                params,
-                aborted,
-                options_vars.count("timeout") ? options_vars["timeout"].as<int>() : 0);
+        if (! cached) {
+            result = run_this(algorithm->second)(
+                    graphs,
+                    params,
+                    aborted,
+                    options_vars.count("timeout") ? options_vars["timeout"].as<int>() : 0);
+
+            if (cache && ! aborted && is_valid_result(graphs, params.induced, result))
+                cache->store(cache_key, result_to_lines(result));
+        }
 
         /* Stop the clock. */
         auto overall_time = duration_cast<milliseconds>(steady_clock::now() - params.start_time);
@@ -167,6 +271,9 @@ auto main(int argc, char * argv[]) -> int
             }
         }
 
+        if (cache && options_vars.count("cache-stats"))
+            cache->write_stats(std::cerr);
+
         return EXIT_SUCCESS;
     }
     catch (const po::error & e) {
@@ -5,6 +5,7 @@
 #include <max_clique/algorithms.hh>
 
 #include <graph/degree_sort.hh>
+#include <graph/random_graph.hh>
 
 #include <boost/program_options.hpp>
 
@@ -12,7 +13,7 @@
 #include <iomanip>
 #include <exception>
 #include <algorithm>
-#include <random>
+#include <cstdint>
 #include <cstdlib>
 #include <thread>
 
@@ -23,7 +24,7 @@ using std::chrono::steady_clock;
 using std::chrono::duration_cast;
 using std::chrono::milliseconds;
 
-std::mt19937 rnd;
+std::uint64_t next_seed = 0;
 
 bool compare(int size, int samples,
         const std::function<MaxCliqueResult (const Graph &, const MaxCliqueParams &)> & algorithm1,
@@ -37,13 +38,7 @@ bool compare(int size, int samples,
         std::cerr << p << " ";
 
         for (int n = 0 ; n < samples ; ++n) {
-            Graph graph(size, false);
-
-            std::uniform_real_distribution<double> dist(0.0, 1.0);
-            for (int e = 0 ; e < size ; ++e)
-                for (int f = e + 1 ; f < size ; ++f)
-                    if (dist(rnd) <= (double(p) / 100.0))
-                        graph.add_edge(e, f);
+            auto graph = random_graph(size, double(p) / 100.0, next_seed++, false);
 
             MaxCliqueParams params1;
             params1.order_function = std::bind(degree_sort, _1, _2, false);
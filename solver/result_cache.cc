@@ -0,0 +1,122 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <solver/result_cache.hh>
+
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include <cerrno>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace parasols;
+
+namespace
+{
+    /* Bumped if what we store changes, so old entries become misses. */
+    const constexpr char cache_version[] = "parasols-result-cache-1";
+
+    auto hash_key(const std::string & key) -> std::uint64_t
+    {
+        /* FNV-1a, which is plenty, since the key is checked on lookup. */
+        std::uint64_t result = 0xcbf29ce484222325ull;
+        for (unsigned char c : key) {
+            result ^= c;
+            result *= 0x100000001b3ull;
+        }
+        return result;
+    }
+}
+
+ResultCacheError::ResultCacheError(const std::string & directory, const std::string & message) throw () :
+    _what("Error using result cache '" + directory + "': " + message)
+{
+}
+
+auto ResultCacheError::what() const throw () -> const char *
+{
+    return _what.c_str();
+}
+
+ResultCache::ResultCache(const std::string & directory) :
+    _directory(directory)
+{
+    if (-1 == ::mkdir(directory.c_str(), 0777) && EEXIST != errno)
+        throw ResultCacheError{ directory, "unable to create directory" };
+
+    struct stat st;
+    if (-1 == ::stat(directory.c_str(), &st) || ! S_ISDIR(st.st_mode))
+        throw ResultCacheError{ directory, "not a directory" };
+}
+
+auto ResultCache::_filename(const std::string & key) const -> std::string
+{
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash_key(key)));
+    return _directory + "/" + name;
+}
+
+auto ResultCache::lookup(const std::string & key, std::vector<std::string> & lines) -> bool
+{
+    std::ifstream infile{ _filename(key) };
+
+    std::string version, stored_key;
+    if (! (infile && std::getline(infile, version) && std::getline(infile, stored_key)
+                && version == cache_version && stored_key == key)) {
+        ++_misses;
+        return false;
+    }
+
+    lines.clear();
+    std::string line;
+    while (std::getline(infile, line))
+        lines.push_back(line);
+
+    ++_hits;
+    return true;
+}
+
+auto ResultCache::reject() -> void
+{
+    --_hits;
+    ++_misses;
+    ++_rejected;
+}
+
+auto ResultCache::store(const std::string & key, const std::vector<std::string> & lines) -> void
+{
+    std::string filename = _filename(key);
+    std::string temporary = filename + ".tmp." + std::to_string(::getpid());
+
+    {
+        std::ofstream outfile{ temporary };
+        outfile << cache_version << '\n' << key << '\n';
+        for (auto & line : lines)
+            outfile << line << '\n';
+
+        outfile.close();
+        if (! outfile) {
+            std::remove(temporary.c_str());
+            ++_store_failures;
+            return;
+        }
+    }
+
+    if (0 != std::rename(temporary.c_str(), filename.c_str())) {
+        std::remove(temporary.c_str());
+        ++_store_failures;
+        return;
+    }
+
+    ++_stored;
+}
+
+auto ResultCache::write_stats(std::ostream & stream) const -> void
+{
+    stream << "cache: " << _hits << " hits, " << _misses << " misses (" << _rejected << " rejected), "
+        << _stored << " stored";
+    if (0 != _store_failures)
+        stream << ", " << _store_failures << " failed to store";
+    stream << std::endl;
+}
@@ -0,0 +1,89 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_SOLVER_RESULT_CACHE_HH
+#define PARASOLS_GUARD_SOLVER_RESULT_CACHE_HH 1
+
+#include <string>
+#include <vector>
+#include <exception>
+#include <ostream>
+
+namespace parasols
+{
+    /**
+     * Thrown if we can't use a result cache directory.
+     */
+    class ResultCacheError :
+        public std::exception
+    {
+        private:
+            std::string _what;
+
+        public:
+            ResultCacheError(const std::string & directory, const std::string & message) throw ();
+
+            auto what() const throw () -> const char *;
+    };
+
+    /**
+     * An on-disk cache of results, so that we don't solve the same instance
+     * twice, even across runs.
+     *
+     * A key describes everything that affects a result: usually the
+     * fingerprint of each graph, the algorithm and its parameters. A result
+     * is stored as lines of text, which are up to the caller to make sense
+     * of. Each entry lives in its own file, named after a hash of its key,
+     * and the whole key is kept in the file too, so a hash collision just
+     * looks like a miss.
+     *
+     * Entries are written to a temporary file and renamed into place, so
+     * many processes can share a cache, and nobody sees half a result.
+     * Callers should only store results that they have verified, and should
+     * verify results that they look up, and reject() those that fail.
+     */
+    class ResultCache
+    {
+        private:
+            std::string _directory;
+
+            unsigned long long _hits = 0, _misses = 0, _rejected = 0, _stored = 0, _store_failures = 0;
+
+            auto _filename(const std::string & key) const -> std::string;
+
+        public:
+            /**
+             * The directory is created if necessary.
+             *
+             * \throw ResultCacheError
+             */
+            explicit ResultCache(const std::string & directory);
+
+            ResultCache(const ResultCache &) = delete;
+            ResultCache & operator= (const ResultCache &) = delete;
+
+            /**
+             * Look up a result, returning true and filling in lines if we
+             * have it.
+             */
+            auto lookup(const std::string & key, std::vector<std::string> & lines) -> bool;
+
+            /**
+             * A result we looked up turned out not to be valid. It counts as
+             * a miss, and will be replaced when the caller stores a new one.
+             */
+            auto reject() -> void;
+
+            /**
+             * Store a result. Failing to do so isn't an error, since we can
+             * always solve the instance again, but it is counted.
+             */
+            auto store(const std::string & key, const std::vector<std::string> & lines) -> void;
+
+            /**
+             * Write a line of statistics.
+             */
+            auto write_stats(std::ostream & stream) const -> void;
+    };
+}
+
+#endif
@@ -1,5 +1,6 @@
 TARGET := libsolver.a
 
 SOURCES := \
+	result_cache.cc \
 	solver.cc
 
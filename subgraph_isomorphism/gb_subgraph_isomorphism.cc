@@ -4,6 +4,7 @@
 #include <subgraph_isomorphism/supplemental_graphs.hh>
 
 #include <graph/bit_graph.hh>
+#include <graph/permute_graph.hh>
 #include <graph/template_voodoo.hh>
 #include <graph/degree_sort.hh>
 
@@ -102,7 +103,7 @@ namespace
         std::array<FixedBitGraph<n_words_>, max_graphs> pattern_graphs;
 
         std::vector<int> pattern_order, target_order, isolated_vertices;
-        std::array<int, n_words_ * bits_per_word> pattern_degree_tiebreak;
+        VertexArray<int, n_words_> pattern_degree_tiebreak;
 
         unsigned pattern_size, full_pattern_size, target_size;
 
@@ -126,22 +127,14 @@ namespace
                     pattern_order.push_back(v);
 
             // recode pattern to a bit graph
-            pattern_graphs.at(0).resize(pattern_size);
-            for (unsigned i = 0 ; i < pattern_size ; ++i)
-                for (unsigned j = 0 ; j < pattern_size ; ++j)
-                    if (pattern.adjacent(pattern_order.at(i), pattern_order.at(j)))
-                        pattern_graphs.at(0).add_edge(i, j);
+            permute_graph(pattern, pattern_order, pattern_graphs.at(0));
 
             // determine ordering for target graph vertices
             std::iota(target_order.begin(), target_order.end(), 0);
             degree_sort(target, target_order, false);
 
             // recode target to a bit graph
-            target_graphs.at(0).resize(target_size);
-            for (unsigned i = 0 ; i < target_size ; ++i)
-                for (unsigned j = 0 ; j < target_size ; ++j)
-                    if (target.adjacent(target_order.at(i), target_order.at(j)))
-                        target_graphs.at(0).add_edge(i, j);
+            permute_graph(target, target_order, target_graphs.at(0));
 
             for (unsigned j = 0 ; j < pattern_size ; ++j)
                 pattern_degree_tiebreak.at(j) = pattern_graphs.at(0).degree(j);
@@ -367,7 +360,7 @@ namespace
         auto cheap_all_different(Domains & domains, FailedVariables & failed_variables) -> bool
         {
             // pick domains smallest first, with tiebreaking
-            std::array<int, n_words_ * bits_per_word> domains_order;
+            VertexArray<int, n_words_> domains_order;
             std::iota(domains_order.begin(), domains_order.begin() + domains.size(), 0);
 
             std::sort(domains_order.begin(), domains_order.begin() + domains.size(),
@@ -4,6 +4,7 @@
 #include <subgraph_isomorphism/supplemental_graphs.hh>
 
 #include <graph/bit_graph.hh>
+#include <graph/permute_graph.hh>
 #include <graph/template_voodoo.hh>
 #include <graph/degree_sort.hh>
 
@@ -258,7 +259,7 @@ namespace
         };
 
         using Domains = std::vector<Domain>;
-        using Assignments = std::array<unsigned, n_words_ * bits_per_word>;
+        using Assignments = VertexArray<unsigned, n_words_>;
 
         struct DummyFailedVariables
         {
@@ -325,7 +326,7 @@ namespace
         std::array<FixedBitGraph<n_words_>, max_graphs> pattern_graphs;
 
         std::vector<int> pattern_order, target_order, isolated_vertices;
-        std::array<int, n_words_ * bits_per_word> pattern_degree_tiebreak;
+        VertexArray<int, n_words_> pattern_degree_tiebreak;
 
         unsigned pattern_size, full_pattern_size, target_size;
 
@@ -355,22 +356,14 @@ namespace
                     pattern_order.push_back(v);
 
             // recode pattern to a bit graph
-            pattern_graphs.at(0).resize(pattern_size);
-            for (unsigned i = 0 ; i < pattern_size ; ++i)
-                for (unsigned j = 0 ; j < pattern_size ; ++j)
-                    if (pattern.adjacent(pattern_order.at(i), pattern_order.at(j)))
-                        pattern_graphs.at(0).add_edge(i, j);
+            permute_graph(pattern, pattern_order, pattern_graphs.at(0));
 
             // determine ordering for target graph vertices
             std::iota(target_order.begin(), target_order.end(), 0);
             degree_sort(target, target_order, false);
 
             // recode target to a bit graph
-            target_graphs.at(0).resize(target_size);
-            for (unsigned i = 0 ; i < target_size ; ++i)
-                for (unsigned j = 0 ; j < target_size ; ++j)
-                    if (target.adjacent(target_order.at(i), target_order.at(j)))
-                        target_graphs.at(0).add_edge(i, j);
+            permute_graph(target, target_order, target_graphs.at(0));
 
             for (unsigned j = 0 ; j < pattern_size ; ++j)
                 pattern_degree_tiebreak.at(j) = pattern_graphs.at(0).degree(j);
@@ -464,7 +457,7 @@ namespace
             FailedVariables shared_failed_variables;
             shared_failed_variables.add(branch_domain->v);
 
-            std::array<int, n_words_ * bits_per_word> branch;
+            VertexArray<int, n_words_> branch;
             int branch_end = 0;
             for (int f_v = remaining.first_set_bit() ; f_v != -1 ; f_v = remaining.first_set_bit()) {
                 remaining.unset(f_v);
@@ -479,7 +472,7 @@ namespace
                 FailedVariables,
                 Assignments>;
 
-            std::array<ThisThreadData, n_words_ * bits_per_word> all_threads_data;
+            VertexArray<ThisThreadData, n_words_> all_threads_data;
 
             auto this_thread_function = [&] () {
                 for (int b = shared_b++ ; b < branch_end ; b = shared_b++) {
@@ -619,7 +612,7 @@ namespace
             FailedVariables shared_failed_variables;
             shared_failed_variables.add(branch_domain->v);
 
-            std::array<int, n_words_ * bits_per_word> branch;
+            VertexArray<int, n_words_> branch;
             int branch_end = 0;
             for (int f_v = remaining.first_set_bit() ; f_v != -1 ; f_v = remaining.first_set_bit()) {
                 remaining.unset(f_v);
@@ -816,7 +809,7 @@ namespace
         auto cheap_all_different(Domains & domains, FailedVariables & failed_variables) -> bool
         {
             // pick domains smallest first, with tiebreaking
-            std::array<int, n_words_ * bits_per_word> domains_order;
+            VertexArray<int, n_words_> domains_order;
             std::iota(domains_order.begin(), domains_order.begin() + domains.size(), 0);
 
             std::sort(domains_order.begin(), domains_order.begin() + domains.size(),
@@ -0,0 +1,6 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <threads/prefetcher.hh>
+
+using namespace parasols;
+
@@ -0,0 +1,138 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef PARASOLS_GUARD_THREADS_PREFETCHER_HH
+#define PARASOLS_GUARD_THREADS_PREFETCHER_HH 1
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <exception>
+#include <list>
+#include <utility>
+
+namespace parasols
+{
+    /**
+     * Loads a sequence of items, such as the input files for a run, in a
+     * separate thread, so that item k + 1 can be loaded whilst item k is
+     * being used.
+     *
+     * The loader runs at most depth items ahead of the consumer, which bounds
+     * how much memory we use. A depth of zero means no loader thread, and
+     * each item is loaded when it is asked for.
+     *
+     * If loading an item throws, the items before it are still handed out in
+     * order, and then next() rethrows the exception.
+     */
+    template <typename Item_>
+    class Prefetcher
+    {
+        private:
+            const std::function<Item_ (unsigned)> _load;
+            const unsigned _n_items, _depth;
+            unsigned _next_item;
+
+            /* These protect and watch all subsequent private members. */
+            std::mutex _mutex;
+            std::condition_variable _cond;
+
+            std::list<Item_> _ready;
+            std::exception_ptr _error;
+            bool _stop;
+
+            std::thread _thread;
+
+            auto _loader() -> void
+            {
+                for (unsigned i = 0 ; i < _n_items ; ++i) {
+                    {
+                        /* Don't get too far ahead. */
+                        std::unique_lock<std::mutex> guard(_mutex);
+                        while (_ready.size() >= _depth && ! _stop)
+                            _cond.wait(guard);
+
+                        if (_stop)
+                            return;
+                    }
+
+                    try {
+                        Item_ item = _load(i);
+
+                        std::unique_lock<std::mutex> guard(_mutex);
+                        _ready.push_back(std::move(item));
+                        _cond.notify_all();
+                    }
+                    catch (...) {
+                        std::unique_lock<std::mutex> guard(_mutex);
+                        _error = std::current_exception();
+                        _cond.notify_all();
+                        return;
+                    }
+                }
+            }
+
+        public:
+            /**
+             * Items are made by calling load(0), load(1) and so on up to
+             * load(n_items - 1), in order.
+             */
+            Prefetcher(unsigned n_items, unsigned depth, const std::function<Item_ (unsigned)> & load) :
+                _load(load),
+                _n_items(n_items),
+                _depth(depth),
+                _next_item(0),
+                _stop(false)
+            {
+                if (0 != _depth)
+                    _thread = std::thread([this] { _loader(); });
+            }
+
+            /**
+             * If we stop early, we still have to wait for any item that is
+             * part way through being loaded.
+             */
+            ~Prefetcher()
+            {
+                if (_thread.joinable()) {
+                    {
+                        std::unique_lock<std::mutex> guard(_mutex);
+                        _stop = true;
+                        _cond.notify_all();
+                    }
+                    _thread.join();
+                }
+            }
+
+            Prefetcher(const Prefetcher &) = delete;
+            Prefetcher & operator= (const Prefetcher &) = delete;
+
+            /**
+             * Get the next item, waiting for it to be loaded if necessary.
+             * Must be called no more than n_items times.
+             */
+            auto next() -> Item_
+            {
+                if (0 == _depth)
+                    return _load(_next_item++);
+
+                std::unique_lock<std::mutex> guard(_mutex);
+                while (_ready.empty() && ! _error)
+                    _cond.wait(guard);
+
+                if (_ready.empty())
+                    std::rethrow_exception(_error);
+
+                Item_ result = std::move(_ready.front());
+                _ready.pop_front();
+                ++_next_item;
+
+                /* The loader may be waiting for space. */
+                _cond.notify_all();
+
+                return result;
+            }
+    };
+}
+
+#endif
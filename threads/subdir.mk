@@ -3,5 +3,6 @@ TARGET := libthreads.a
 SOURCES := \
 	atomic_incumbent.cc \
 	output_lock.cc \
+	prefetcher.cc \
 	queue.cc
 